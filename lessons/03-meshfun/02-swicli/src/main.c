@@ -17,6 +17,10 @@
   #include "bluccino.h"                // access bluccino stuff
   #include "bl_gonoff.h"               // generic on/off model
 
+  #ifndef CFG_LPN
+    #define CFG_LPN  0                 // no low power node profile
+  #endif
+
   int app(BL_ob *o, int val)           // public APP module interface
   {
     if (bl_is(o,_SWITCH,STS_))         // switch status update
@@ -27,5 +31,5 @@
   void main(void)
   {
     bl_hello(4,PROJECT);               // set verbose level, print hello message
-    bl_engine(app,10,1000);            // run app with 10/1000ms ticks/tocks
+    bl_engine(app,CFG_LPN?0:10,1000);  // 10/1000ms ticks/tocks (LPN: no ticks)
   }
@@ -21,7 +21,7 @@
            "GOOCLI","GOOSRV","GLVCLI","GLVSRV",\
            "BUTTON","SWITCH","LED","NODE","STATE", \
            "CTRL","SCAN","ADV","ADVT","SOS","NVM","TRANS","BT", \
-           "CTS","PIN","TOF","DIGITAL","ANALOG","IO"
+           "CTS","PIN","TOF","DIGITAL","ANALOG","IO","SPI"
 
   #define BL_CL_ENUMS \
             _VOID = 0x7FFF,_SYS = 1, \
@@ -30,7 +30,7 @@
             _CFGCLI,_CFGSRV,_HEACLI,_HEASRV,_GOOCLI,_GOOSRV,_GLVCLI,_GLVSRV, \
             _BUTTON,_SWITCH,_LED,_NODE,_STATE, \
             _CTRL,_SCAN,_ADV,_ADVT,_SOS,_NVM,_TRANS,_BT, \
-            _CTS,_PIN,_TOF,_DIGITAL,_ANALOG,_IO
+            _CTS,_PIN,_TOF,_DIGITAL,_ANALOG,_IO,_SPI
 
 //==============================================================================
 // message opcode symbols
@@ -47,7 +47,8 @@
           "START","STOP","CONNECT","DISCON","MTU","RECEIPE","BATTERY","ISR", \
           "SERVICE","SUPPORT","IBEACON","EDDY","DIS","HRS","BAS","CTS", \
           "FULL","ATTACH","DATA","RANGE","DIST","INPUT","OUTPUT", \
-          "DEVICE","NUSSRV","NUSCLI","FOTA"
+          "DEVICE","NUSSRV","NUSCLI","FOTA","FLUSH","SETMASK","GETPORT","FRAME", \
+          "TX","RX","TRANS"
 
   #define BL_OP_ENUMS \
           VOID_ = 0x7FFF,INIT_ = 1,                                  \
@@ -61,6 +62,7 @@
           START_,STOP_,CONNECT_,DISCON_,MTU_,RECEIPE_,BATTERY_,ISR_, \
           SERVICE_,SUPPORT_,IBEACON_,EDDY_,DIS_,HRS_,BAS_,CTS_,      \
           FULL_,ATTACH_,DATA_,RANGE_,DIST_,INPUT_,OUTPUT_,DEVICE_,   \
-          NUSSRV_,NUSCLI_,FOTA_
+          NUSSRV_,NUSCLI_,FOTA_,FLUSH_,SETMASK_,GETPORT_,FRAME_,    \
+          TX_,RX_,TRANS_
 
 #endif // __BL_DEFS_H__
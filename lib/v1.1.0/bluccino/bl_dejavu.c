@@ -0,0 +1,100 @@
+//==============================================================================
+//  bl_dejavu.c
+//  de-ja-vu cache - drop repeated mesh transactions of any server model
+//
+//  Created by Hugo Pristauz on 19.02.2022
+//  Copyright © 2022 Bluenetics GmbH. All rights reserved.
+//==============================================================================
+
+  #include "bl_mesh.h"
+
+//==============================================================================
+// de-ja-vu cache
+// - small open addressed hash table, shared by all server models
+// - key is (src,dst,tid,model), a lookup probes CFG_DEJAVU_PROBES entries
+// - entries older than CFG_DEJAVU_MS (6 s as per mesh spec) count as free
+//==============================================================================
+
+  #ifndef CFG_DEJAVU_SLOTS
+    #define CFG_DEJAVU_SLOTS    16     // number of cache entries (power of 2)
+  #endif
+  #ifndef CFG_DEJAVU_PROBES
+    #define CFG_DEJAVU_PROBES   4      // max number of probes per lookup
+  #endif
+  #ifndef CFG_DEJAVU_MS
+    #define CFG_DEJAVU_MS       6000   // de-ja-vu time window [ms]
+  #endif
+
+  static BL_dejavu dejavu[CFG_DEJAVU_SLOTS];
+  static int dejavu_hits = 0;          // number of repeats detected
+  static int dejavu_misses = 0;        // number of new transactions
+
+  static unsigned dejavu_hash(const BL_model *model, BL_u16 src, BL_u16 dst,
+                              BL_u8 tid)
+  {
+    unsigned h = (unsigned)(uintptr_t)model >> 2;
+
+    h = h*31 + src;
+    h = h*31 + dst;
+    h = h*31 + tid;
+    return (h ^ (h >> 8)) & (CFG_DEJAVU_SLOTS-1);
+  }
+
+  static bool dejavu_match(BL_dejavu *p, const BL_model *model, BL_u16 src,
+                           BL_u16 dst, BL_u8 tid)
+  {
+    return (p->model == model && p->tid == tid && p->src == src &&
+            p->dst == dst);
+  }
+
+    bool bl_dejavu(const BL_model *model, BL_ctx *ctx, BL_u8 tid, BL_ms now)
+    {
+      BL_u16 src = ctx->addr, dst = ctx->recv_dst;
+      unsigned h = dejavu_hash(model,src,dst,tid);
+
+      for (int i=0; i < CFG_DEJAVU_PROBES; i++)
+      {
+        BL_dejavu *p = dejavu + ((h+i) & (CFG_DEJAVU_SLOTS-1));
+
+        if (dejavu_match(p,model,src,dst,tid) && now - p->time <= CFG_DEJAVU_MS)
+        {
+          dejavu_hits++;
+          return true;
+        }
+      }
+
+      dejavu_misses++;
+      return false;
+    }
+
+    void bl_dejavu_add(const BL_model *model, BL_ctx *ctx, BL_u8 tid, BL_ms now)
+    {
+      BL_u16 src = ctx->addr, dst = ctx->recv_dst;
+      unsigned h = dejavu_hash(model,src,dst,tid);
+      BL_dejavu *slot = NULL;
+
+      for (int i=0; i < CFG_DEJAVU_PROBES; i++)
+      {
+        BL_dejavu *p = dejavu + ((h+i) & (CFG_DEJAVU_SLOTS-1));
+
+        if (dejavu_match(p,model,src,dst,tid))
+        {
+          slot = p;                    // refresh existing entry
+          break;
+        }
+        else if (!slot || p->time < slot->time)
+          slot = p;                    // free, aged or oldest entry
+      }
+
+      slot->model = model;
+      slot->tid = tid;
+      slot->src = src;
+      slot->dst = dst;
+      slot->time = now;
+    }
+
+    void bl_dejavu_stats(int *hits, int *misses)
+    {
+      *hits = dejavu_hits;
+      *misses = dejavu_misses;
+    }
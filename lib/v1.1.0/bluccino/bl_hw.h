@@ -19,15 +19,21 @@
 // [LED:op] message definition
 // - [LED:SET @ix,onoff] set LED @ix on/off (i=0..4)
 // - [LED:TOGGLE @ix] toggle LED @ix (i=0..4)
+// - [LED:LEVEL @ix,level] set brightness level (0..100) of LED @ix (i=0..4)
+// - [LED:BLINK @ix,"pattern",ms] run LED animation (ms per pattern character)
 //==============================================================================
 
   #define LED_SET_ix_0_onoff      BL_ID(_LED,SET_)
   #define LED_TOGGLE_ix_0_0       BL_ID(_LED,TOGGLE_)
+  #define LED_LEVEL_ix_0_level    BL_ID(_LED,LEVEL_)
+  #define LED_BLINK_ix_pat_ms     BL_ID(_LED,BLINK_)
 
     // augmented messages
 
   #define _LED_SET_ix_0_onoff     _BL_ID(_LED,SET_)
   #define _LED_TOGGLE_ix_0_0      _BL_ID(_LED,TOGGLE_)
+  #define _LED_LEVEL_ix_0_level   _BL_ID(_LED,LEVEL_)
+  #define _LED_BLINK_ix_pat_ms    _BL_ID(_LED,BLINK_)
 
 //==============================================================================
 // [BUTTON:op] message definition
@@ -114,6 +120,7 @@
 // - [NVM:STORE @ix,val] store value in NVM at location @ix
 // - [NVM:RECALL @ix] recall value in NVM at location @ix
 // - [NVM:AVAIL] is NVM functionality available? (return ok value >= 0)
+// - [NVM:FLUSH] write all pending NVM data to flash (e.g. before power down)
 //==============================================================================
 
   #define NVM_LOAD_0_BL_tray_0    BL_ID(_NVM,LOAD_)
@@ -123,6 +130,7 @@
   #define NVM_READY_0_0_sts       BL_ID(_NVM,READY_)
   #define NVM_SUPPORT_0_0_0       BL_ID(_NVM,SUPPORT_)
   #define NVM_CLEAR_0_0_0         BL_ID(_NVM,CLEAR_)
+  #define NVM_FLUSH_0_0_0         BL_ID(_NVM,FLUSH_)
 
     // augmented messages
 
@@ -133,6 +141,7 @@
   #define _NVM_READY_0_0_sts      _BL_ID(_NVM,READY_)
   #define _NVM_SUPPORT_0_0_0      _BL_ID(_NVM,SUPPORT_)
   #define _NVM_CLEAR_0_0_0        _BL_ID(_NVM,CLEAR_)
+  #define _NVM_FLUSH_0_0_0        _BL_ID(_NVM,FLUSH_)
 /*
 #ifdef __cplusplus
 
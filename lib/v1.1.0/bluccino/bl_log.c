@@ -19,6 +19,29 @@
   static BL_txt color = "";            // text color for time header
   static int debug = 4;                // debug level
 
+//==============================================================================
+// log time stamp in us with cycle counter resolution
+// - the cycle clock is anchored to bl_us() and re-anchored whenever both
+//   clocks differ by more than 1 ms (e.g. after a missed 32-bit wrap)
+//==============================================================================
+
+  static BL_us stamp(void)
+  {
+    static BL_us base = 0;                 // bl_us() time of anchor
+    static BL_cyc tic = 0;                 // cycle count of anchor
+
+    BL_us us = bl_us();
+    BL_cyc cyc = bl_cycles();
+    BL_us t = base + (BL_us)(bl_cyc2ns(cyc - tic) / 1000);
+
+    if (tic == 0 || t < us - 1000 || t > us + 1000)
+    {
+      base = t = us;                       // (re-)anchor cycle clock
+      tic = cyc;
+    }
+    return t;
+  }
+
 //==============================================================================
 // get clock time as minutes, seconds, milliseconds
 //==============================================================================
@@ -28,7 +51,7 @@
     static int min = 0;
     static int sec = 0;
     static BL_ms offset = 0;
-    BL_us us = bl_us();                    // clock time now in us
+    BL_us us = stamp();                    // clock time now in us
 
     *pus = us % 1000;                      // map us to range 0 .. 999
     *pms = us/1000 - offset;
@@ -501,6 +501,12 @@
         return pel->addr;
     }
 
+//==============================================================================
+// de-ja-vu cache (shared with cores not based on bl_mesh.c)
+//==============================================================================
+
+  #include "bl_dejavu.c"
+
 //==============================================================================
 // provisioning link has been opened
 //==============================================================================
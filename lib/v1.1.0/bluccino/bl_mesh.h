@@ -148,17 +148,18 @@
 
     typedef struct BL_dejavu
     {
+        const BL_model *model;     // model instance of de-ja-vu (NULL: free)
         uint8_t tid;               // transaction ID of de-ja-vu
         uint16_t src;              // source address of de-ja-vu
         uint16_t dst;              // destination address of de-ja-vu
-        BL_ms time;             // time stamp of de-ja-vu
+        BL_ms time;                // time stamp of de-ja-vu
     } BL_dejavu;
 
 //==============================================================================
 // short hand for Zephyr structure types
 //==============================================================================
 
-#define BL_DNP_DATA_LENGTH 8
+#define BL_DNP_DATA_LENGTH 16  // 32-bit vendor bulk update (opcode + payload)
 
     typedef struct BL_msg  // message data structure, containing data buffer, net-buffer & publisher
     {
@@ -277,6 +278,16 @@
     FL_addr bl_dst(BL_ctx *ctx);        // destination address of mesh message
     FL_addr bl_me(BL_model *pmod);      // model's element address
 
+//==============================================================================
+// de-ja-vu cache (drop repeated transactions of any server model)
+// - bl_dejavu() returns true if (src,dst,tid,model) has been seen recently
+// - bl_dejavu_add() remembers a transaction once it has been accepted
+//==============================================================================
+
+    bool bl_dejavu(const BL_model *model, BL_ctx *ctx, uint8_t tid, BL_ms now);
+    void bl_dejavu_add(const BL_model *model, BL_ctx *ctx, uint8_t tid, BL_ms now);
+    void bl_dejavu_stats(int *hits, int *misses);
+
 //==============================================================================
 // mesh init
 //==============================================================================
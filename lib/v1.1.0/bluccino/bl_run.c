@@ -55,7 +55,7 @@
 
   #define PERIOD CFG_RUN_LOG_PERIOD
 
-  static BL_run run = {0,0,0,0,0,PERIOD,0};      // run monitoring data
+  static BL_run run = {0,0,0,0,0,0,PERIOD,0};    // run monitoring data
 
 #endif
 //==============================================================================
@@ -77,24 +77,27 @@
     run.tick = tick;  run.tock = tock;
     run.due = now + run.period;
     run.duty = run.total = 0;
-    run.start = run.tic = bl_us();
+    run.cycles = 0;
+    run.start = bl_us();
+    run.tic = bl_cycles();
   }
 
   static void moni_suspend(void)
   {
-    BL_us toc = bl_us();                    // toc (end) time of asses. segment
-    run.duty += (toc-run.tic);              // add up segment time to duty time
-    run.tic = bl_us();                      // refresh segment tic time
+    BL_cyc toc = bl_cycles();               // toc (end) cycles of segment
+    run.cycles += (toc-run.tic);            // add up segment cycles
+    run.tic = toc;                          // refresh segment tic cycles
   }
 
   static void moni_resume(void)
   {
-    run.tic = bl_us();                      // refresh segment tic time
+    run.tic = bl_cycles();                  // refresh segment tic cycles
   }
 
   static void moni_stop(void)
   {
     moni_suspend();
+    run.duty = (BL_us)(bl_cyc2ns(run.cycles) / 1000);
     run.total = bl_us() - run.start;
   }
 
@@ -214,9 +217,74 @@
     return (ms < 0) ? 0 : ms;        // return non negative delay time
   }
 
+//==============================================================================
+// wake up event driven run loop
+// - usage: bl_wake()                  // emit [SYS:TICK] in event driven mode
+//==============================================================================
+
+  static K_SEM_DEFINE(run_wake,0,1);   // event driven mode wake up
+
+  void bl_wake(void)
+  {
+    k_sem_give(&run_wake);             // (ISR safe)
+  }
+
+//==============================================================================
+// event driven run loop (tick period 0)
+// - no periodic ticks: sleep until bl_wake() (=> one [SYS:TICK]) or until
+//   the next tock is due (=> [SYS:TOCK])
+//==============================================================================
+
+  static void run_events(BL_oval A, BL_oval G, BL_oval T, BL_pace *tock)
+  {
+    BL_pace tick = BL_PACE(0,0);
+    BL_ob oo_tick = {_SYS,TICK_,0,&tick};
+    BL_ob oo_tock = {_SYS,TOCK_,1,tock};
+    int ticks = 0, tocks = 0;
+
+    LOG(2,"event driven mode - tock period %d ms",(int)tock->period);
+    moni_start(bl_ms(),0,tock->period);
+
+    for (;;)
+    {
+      BL_ms now = bl_ms();
+
+      if (tock->period && now >= tock->time)
+      {
+        bl_fwd(&oo_tock,tocks,G);      // tock BLUCCINO module
+        if (A)
+          bl_fwd(&oo_tock,tocks,A);    // tock APP module
+        if (T)
+          bl_fwd(&oo_tock,tocks,T);    // tock TEST module
+        tocks++;
+        tock->time += tock->period;    // increase tock time
+        continue;
+      }
+
+      k_timeout_t timeout = tock->period ? K_MSEC(tock->time - now) : K_FOREVER;
+
+      moni_suspend();                  // suspend run monitoring
+      bool woke = (k_sem_take(&run_wake,timeout) == 0);
+      moni_log(bl_ms());               // log results if due
+      moni_resume();                   // resume run monitoring
+
+      if (woke)                        // post [SYS:TICK] on wake up
+      {
+        tick.time = bl_ms();
+        bl_fwd(&oo_tick,ticks,G);      // tick bluccino module
+        if (A)
+          bl_fwd(&oo_tick,ticks,A);    // tick APP module
+        if (T)
+          bl_fwd(&oo_tick,ticks,T);    // tick TEST module
+        ticks++;
+      }
+    }
+  }
+
 //==============================================================================
 // run app with given tick/tock periods and provided when-callback
 // - usage: bl_run(app,10,100,when)    // run app with 10/1000 tick/tock periods
+//          bl_run(app,0,1000,when)    // event driven mode (no periodic ticks)
 //==============================================================================
 
   __weak void bl_run(BL_oval app, int tick_ms, int tock_ms, BL_oval when)
@@ -232,9 +300,9 @@
     BL_ob oo_tick = {_SYS,TICK_,0,&tick};
     BL_ob oo_tock = {_SYS,TOCK_,1,&tock};
 
-    int multiple = tock.period / tick.period;
+    int multiple = tick.period ? tock.period / tick.period : 0;
 
-    if (tock_ms % tick_ms != 0)
+    if (tick_ms && tock_ms % tick_ms != 0)
       bl_err(-1,"bl_engine: tock period no multiple of tick period");
 
       // init Bluccino library module and app init
@@ -256,6 +324,11 @@
         bl_sleep(1000);
     }
 
+      // zero tick period with non-zero tock period: event driven mode
+
+    if (tick.period == 0)
+      run_events(A,G,T,&tock);         // never returns
+
       // post periodic ticks and tocks ...
 
     moni_start(tick.time,tick.period,tock.period);
@@ -132,7 +132,8 @@
           {
             BL_ms due;            // when is assessment period due (ms)?
             BL_us start;          // start clock us-time of assessment segment
-            BL_us tic;            // tic (begin) time of assessment segment
+            BL_cyc tic;           // tic (begin) cycles of assessment segment
+            BL_cyc cycles;        // cumulated duty cycles of period
             BL_us duty;           // cumulated duty us-time of period
             BL_us total;          // total cumulated time of assessment
             BL_ms period;         // run logging period
@@ -224,10 +225,18 @@
 //==============================================================================
 // run app with given tick/tock periods and provided when-callback
 // - usage: bl_run((app),10,100,(when)) // run app with 10/1000 tick/tock periods
+//          bl_run((app),0,1000,(when)) // event driven (no periodic ticks)
 //==============================================================================
 
   void bl_run(BL_oval app, int tick_ms, int tock_ms, BL_oval when);
 
+//==============================================================================
+// wake up run loop in event driven mode (tick_ms = 0)
+// - usage: bl_wake()                  // post one [SYS:TICK] to bluccino & app
+//==============================================================================
+
+  void bl_wake(void);
+
 //==============================================================================
 // syntactic sugar: run app where app()and when() function are the same
 // - usage: bl_engine((app),10,100)    // run app with 10/1000 tick/tock periods
@@ -189,10 +189,12 @@
 // [MESH:] message definitions
 // - [MESH:PRV sts]  update mesh provision status
 // - [MESH:ATT sts]  update mesh attention status
+// - [MESH:READY 1]  BLE/mesh is ready (settings loaded, provisioning enabled)
 //==============================================================================
 
   #define MESH_PRV_0_0_sts       BL_ID(_MESH,PRV_)
   #define MESH_ATT_0_0_sts       BL_ID(_MESH,ATT_)
+  #define MESH_READY_0_0_1       BL_ID(_MESH,READY_)
   #define GET_ATT_0_0_0          BL_ID(_GET,ATT_)
   #define GET_PRV_0_0_0          BL_ID(_GET,PRV_)
   #define STATE_ATT_0_BL_pint_0  BL_ID(_STATE,ATT_)
@@ -202,6 +204,7 @@
 
   #define _MESH_PRV_0_0_sts      _BL_ID(_MESH,PRV_)
   #define _MESH_ATT_0_0_sts      _BL_ID(_MESH,ATT_)
+  #define _MESH_READY_0_0_1      _BL_ID(_MESH,READY_)
   #define _GET_ATT_0_0_0         _BL_ID(_GET,ATT_)
   #define _GET_PRV_0_0_0         _BL_ID(_GET,PRV_)
   #define _STATE_ATT_0_BL_pint_0 _BL_ID(_STATE,ATT_)
@@ -8,6 +8,10 @@
 
   #include "bluccino.h"
 
+  #ifndef __ZEPHYR__
+    #include <time.h>
+  #endif
+
 //==============================================================================
 // TIME level logging shorthands
 //==============================================================================
@@ -16,6 +20,74 @@
   #define LOGO(lvl,col,o,val)     LOGO_TIME(lvl,col"api:",o,val)
   #define LOG0(lvl,col,o,val)     LOGO_TIME(lvl,col,o,val)
 
+//==============================================================================
+// cycle counter clock
+//==============================================================================
+#ifdef __ZEPHYR__
+
+  BL_cyc bl_cycles(void)               // 64-bit cycle counter
+  {
+    #if defined(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)
+      return k_cycle_get_64();
+    #else
+        // detects one wrap between two calls only (67s at 64 MHz)
+      static uint32_t last = 0;        // last 32-bit counter value
+      static uint32_t high = 0;        // software extension (upper 32 bit)
+
+      unsigned key = irq_lock();
+      uint32_t cyc = k_cycle_get_32();
+      if (cyc < last)
+        high++;                        // counter wrapped since last call
+      last = cyc;
+      irq_unlock(key);
+
+      return ((BL_cyc)high << 32) | cyc;
+    #endif
+  }
+
+  static uint64_t frequency(void)      // cycle counter frequency (Hz)
+  {
+    return sys_clock_hw_cycles_per_sec();
+  }
+
+#else // host
+
+  BL_cyc bl_cycles(void)               // host: ns clock acts as cycle counter
+  {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (BL_cyc)ts.tv_sec*1000000000 + ts.tv_nsec;
+  }
+
+  static uint64_t frequency(void)      // host cycle counter frequency (Hz)
+  {
+    return 1000000000;
+  }
+
+#endif
+//==============================================================================
+// convert cycles to ns
+// - ns = cyc * 10^9/f is computed as (cyc * mult) >> shift, with mult < 2^32
+//   pre-scaled once, and split in upper/lower 32 bit to avoid overflow
+//==============================================================================
+
+  uint64_t bl_cyc2ns(BL_cyc cyc)
+  {
+    static uint64_t mult = 0;          // scaled ns per cycle
+    static int shift = 32;
+
+    if (mult == 0)                     // init scaling on first call
+    {
+      uint64_t f = frequency();
+      while (((uint64_t)1000000000 << shift) / f >= ((uint64_t)1 << 32))
+        shift--;
+      mult = ((uint64_t)1000000000 << shift) / f;
+    }
+
+    uint64_t hi = cyc >> 32, lo = (uint32_t)cyc;
+    return ((hi*mult) << (32-shift)) + ((lo*mult) >> shift);
+  }
+
 //==============================================================================
 // us/ms clock
 //==============================================================================
@@ -24,12 +96,10 @@
 
   static BL_us now_us()                // system clock in us
   {
-    #ifdef __ZEPHYR__
-      uint64_t cyc = k_uptime_ticks();
-      uint64_t f = sys_clock_hw_cycles_per_sec();
-      return (BL_us)((1000000*cyc)/f);
+    #ifdef __ZEPHYR__                  // kernel uptime, never misses a wrap
+      return (BL_us)k_ticks_to_us_floor64(k_uptime_ticks());
     #else
-      return (BL_us)timer_now();
+      return (BL_us)(bl_cyc2ns(bl_cycles()) / 1000);  // 64-bit host clock
     #endif
   }
 
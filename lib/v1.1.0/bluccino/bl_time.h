@@ -20,6 +20,35 @@
   BL_us bl_us(void);                   // get current clock time in us
   BL_ms bl_ms(void);                   // get current clock time in ms
 
+//==============================================================================
+// cycle counter clock (high resolution time stamps)
+// - bl_cycles() returns the 64-bit hardware cycle counter (a 32-bit counter is
+//   extended in software, which requires a call at least once per wrap)
+// - bl_cyc2ns() converts cycles to ns by a pre-scaled multiply and shift
+// - bl_cyc32() is the cheapest time stamp for short intervals, the unsigned
+//   difference (uint32_t)(toc - tic) is wrap-around safe
+// - usage: uint32_t tic = bl_cyc32();
+//          handler(o,val);
+//          uint64_t ns = bl_cyc2ns((uint32_t)(bl_cyc32() - tic));
+//==============================================================================
+
+  BL_cyc bl_cycles(void);              // 64-bit cycle counter
+  uint64_t bl_cyc2ns(BL_cyc cyc);      // convert cycles to ns
+
+  static inline uint64_t bl_ns(void)   // cycle counter clock in ns
+  {
+    return bl_cyc2ns(bl_cycles());
+  }
+
+  static inline uint32_t bl_cyc32(void)// 32-bit cycle counter (cheap)
+  {
+    #ifdef __ZEPHYR__
+      return k_cycle_get_32();
+    #else
+      return (uint32_t)bl_cycles();
+    #endif
+  }
+
 //==============================================================================
 // periode detection
 // - usage: ok = bl_period(o,ms)        // is tick/tock time meeting a period?
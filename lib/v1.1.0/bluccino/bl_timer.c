@@ -125,6 +125,283 @@
     return 0;
   }
 
+//==============================================================================
+// software timers: hierarchical timing wheel
+// - level 0: 64 slots of 1 tick, level 1: 64 slots of 64 ticks, level 2: 64
+//   slots of 4096 ticks; timers beyond are parked in level 2 and re-sorted
+//   when their slot is cascaded
+// - all wheel and pending list operations are protected by a spinlock, OVAL
+//   callbacks are always called without holding the lock
+//==============================================================================
+
+  #define WHEEL_BITS    6
+  #define WHEEL_SLOTS   (1 << WHEEL_BITS)
+  #define WHEEL_MASK    (WHEEL_SLOTS - 1)
+  #define WHEEL_LEVELS  3
+
+  static BL_slink *wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+  static uint32_t wnow = 0;            // current wheel tick
+  static int wactive = 0;              // number of armed software timers
+
+  static BL_slink *wpending = NULL;    // thread delivery batch (FIFO)
+  static BL_slink **wptail = &wpending; // tail of pending list
+
+  static struct k_spinlock wlock;
+  static struct k_timer wheel_timer;
+  static struct k_work wheel_work;
+  static bool wrunning = false;        // is wheel_timer running?
+
+//==============================================================================
+// helper: intrusive list operations
+//==============================================================================
+
+  static void slink(BL_slink **head, BL_slink *l)
+  {
+    l->next = *head;
+    if (*head)
+      (*head)->pprev = &l->next;
+    *head = l;
+    l->pprev = head;
+  }
+
+  static void sunlink(BL_slink *l)
+  {
+    if (!l->pprev)
+      return;                          // not linked
+
+    *l->pprev = l->next;
+    if (l->next)
+      l->next->pprev = l->pprev;
+    l->next = NULL;  l->pprev = NULL;
+  }
+
+  static void pend(BL_stimer *p)       // append to pending list
+  {
+    if (p->pl.pprev)
+      return;                          // already pending (coalesce)
+
+    p->pl.next = NULL;
+    p->pl.pprev = wptail;
+    *wptail = &p->pl;
+    wptail = &p->pl.next;
+  }
+
+  static void unpend(BL_stimer *p)     // remove from pending list
+  {
+    if (p->pl.pprev && !p->pl.next)
+      wptail = p->pl.pprev;            // removing last element
+    sunlink(&p->pl);
+  }
+
+//==============================================================================
+// helper: insert timer into timing wheel according to due tick (lock held)
+//==============================================================================
+
+  static void insert(BL_stimer *p)
+  {
+    uint32_t delta = p->due - wnow;
+    int level = 0;
+    uint32_t slot;
+
+    if (delta < WHEEL_SLOTS)
+      slot = p->due;
+    else if (delta < (1u << 2*WHEEL_BITS))
+      level = 1, slot = p->due >> WHEEL_BITS;
+    else if (delta < (1u << 3*WHEEL_BITS))
+      level = 2, slot = p->due >> 2*WHEEL_BITS;
+    else                               // park in farthest level 2 slot
+      level = 2, slot = (wnow >> 2*WHEEL_BITS) + WHEEL_MASK;
+
+    slink(&wheel[level][slot & WHEEL_MASK], &p->wl);
+  }
+
+//==============================================================================
+// helper: cascade timers of a wheel slot down to lower levels (lock held)
+//==============================================================================
+
+  static void cascade(int level, uint32_t slot)
+  {
+    BL_slink *l = wheel[level][slot & WHEEL_MASK];
+    wheel[level][slot & WHEEL_MASK] = NULL;
+
+    while (l)
+    {
+      BL_slink *next = l->next;
+      l->pprev = NULL;  l->next = NULL;
+      insert(CONTAINER_OF(l,BL_stimer,wl));
+      l = next;
+    }
+  }
+
+//==============================================================================
+// helper: deliver a timer message (lock not held)
+//==============================================================================
+
+  static void deliver(BL_stimer *p)
+  {
+    if ( !bl_is(&p->oo,_VOID,VOID_) )
+    {
+      LOGO(5,"software timer firing:",&p->oo,p->val);
+      p->oval(&p->oo,p->val);          // post message to receiver module
+    }
+  }
+
+//==============================================================================
+// worker: deliver pending batch in thread context
+//==============================================================================
+
+  static void wheel_worker(struct k_work *w)
+  {
+    for (;;)
+    {
+      k_spinlock_key_t key = k_spin_lock(&wlock);
+      BL_slink *l = wpending;
+
+      if (!l)
+      {
+        k_spin_unlock(&wlock,key);
+        return;
+      }
+
+      BL_stimer *p = CONTAINER_OF(l,BL_stimer,pl);
+      unpend(p);
+      k_spin_unlock(&wlock,key);
+
+      deliver(p);
+    }
+  }
+
+//==============================================================================
+// callback: wheel tick (kernel timer expiry, ISR context)
+// - all timers due at this tick are removed in one batch, periodic timers are
+//   re-armed (drift free), ISR timers are delivered directly after releasing
+//   the lock, thread timers are queued for one worker run
+//==============================================================================
+
+  static void wheel_tick(struct k_timer *t)
+  {
+    BL_slink *batch = NULL;            // ISR delivery batch
+    bool submit = false;
+
+    k_spinlock_key_t key = k_spin_lock(&wlock);
+
+    wnow++;
+    if ((wnow & WHEEL_MASK) == 0)      // level 0 wrapped => cascade
+    {
+      if (((wnow >> WHEEL_BITS) & WHEEL_MASK) == 0)
+        cascade(2, wnow >> 2*WHEEL_BITS);
+      cascade(1, wnow >> WHEEL_BITS);
+    }
+
+    BL_slink *l = wheel[0][wnow & WHEEL_MASK];
+    wheel[0][wnow & WHEEL_MASK] = NULL;
+
+    while (l)
+    {
+      BL_slink *next = l->next;
+      BL_stimer *p = CONTAINER_OF(l,BL_stimer,wl);
+      l->pprev = NULL;  l->next = NULL;
+
+      if (p->period)
+      {
+        p->due += p->period;           // re-arm periodic timer
+        insert(p);
+      }
+      else
+        wactive--;                     // single shot timer expired
+
+      if (p->isr)
+      {
+        p->pl.next = batch;            // deliver after unlock (pl link is
+        batch = &p->pl;                // not used otherwise by ISR timers)
+      }
+      else
+      {
+        pend(p);                       // deliver by worker
+        submit = true;
+      }
+      l = next;
+    }
+
+    if (wactive == 0)
+    {
+      wrunning = false;
+      k_timer_stop(t);
+    }
+
+    k_spin_unlock(&wlock,key);
+
+    while (batch)
+    {
+      BL_slink *next = batch->next;
+      deliver(CONTAINER_OF(batch,BL_stimer,pl));
+      batch = next;
+    }
+
+    if (submit)
+      k_work_submit(&wheel_work);
+  }
+
+//==============================================================================
+// software timer start/stop function calls
+// - usage: static BL_stimer timer = BL_STIMER(module);
+//          bl_stimer(&timer,o,val,50); // start repeat timer @ 50 ms period
+//          bl_stimer(&timer,o,val,-8); // start single shot timer @ 8 ms later
+//          bl_stimer(&timer,o,val,0);  // stop timer and post stop message
+//          bl_stimer(&timer,NULL,0,0); // stop timer without stop message
+//==============================================================================
+
+  int bl_stimer(BL_stimer *p, BL_ob *o, int val, int ms)
+  {
+    static bool init = false;
+    BL_ob oo = {_VOID,VOID_,0,NULL};
+
+    k_spinlock_key_t key = k_spin_lock(&wlock);
+
+    if (!init)
+    {
+      k_timer_init(&wheel_timer, wheel_tick, NULL);
+      k_work_init(&wheel_work, wheel_worker);
+      init = true;
+    }
+
+    if (p->wl.pprev)                   // disarm if armed
+    {
+      sunlink(&p->wl);
+      wactive--;
+    }
+    unpend(p);                         // cancel pending delivery
+
+    p->oo = o ? *o : oo;  p->val = val;
+
+    if (ms == 0)
+    {
+      k_spin_unlock(&wlock,key);
+      LOGO(5,"stop software timer:",&p->oo,p->val);
+      deliver(p);                      // post stop message (if any)
+      return 0;
+    }
+
+    int dt = ms > 0 ? ms : -ms;
+    uint32_t ticks = (dt + CFG_STIMER_TICK_MS - 1) / CFG_STIMER_TICK_MS;
+    ticks = ticks ? ticks : 1;
+
+    p->period = ms > 0 ? ticks : 0;
+    p->due = wnow + ticks;
+    insert(p);
+    wactive++;
+
+    if (!wrunning)
+    {
+      wrunning = true;
+      k_timer_start(&wheel_timer, K_MSEC(CFG_STIMER_TICK_MS),
+                    K_MSEC(CFG_STIMER_TICK_MS));
+    }
+
+    k_spin_unlock(&wlock,key);
+    return 0;
+  }
+
 //==============================================================================
 // cleanup (needed for *.c file merge of the bluccino core)
 //==============================================================================
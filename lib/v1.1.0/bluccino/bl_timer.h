@@ -37,4 +37,55 @@
 
   int bl_timer(BL_timer *p, BL_ob *o, int val, int ms);
 
+//==============================================================================
+// software timers (BL_stimer), multiplexed on a single kernel timer
+// - each BL_timer embeds its own k_timer and always runs its receiver in ISR
+//   context, while any number of BL_stimer timers share one k_timer which
+//   drives a hierarchical timing wheel (3 levels of 64 slots each)
+// - start/stop are O(1), all timers expiring at the same tick are processed
+//   as one batch
+// - BL_STIMER(cb): receiver runs in thread context (system work queue)
+// - BL_STIMER_ISR(cb): receiver runs in ISR context (like BL_timer)
+// - resolution is CFG_STIMER_TICK_MS, the kernel timer only runs while there
+//   are active software timers
+//==============================================================================
+
+  #ifndef CFG_STIMER_TICK_MS
+    #define CFG_STIMER_TICK_MS  10     // timing wheel tick (ms)
+  #endif
+
+  typedef struct BL_slink              // intrusive list link
+          {
+            struct BL_slink *next;     // next link
+            struct BL_slink **pprev;   // pointer to previous next (NULL: free)
+          } BL_slink;
+
+  typedef struct BL_stimer
+          {
+            BL_slink wl;               // timing wheel slot link
+            BL_slink pl;               // pending (batch) list link
+            BL_oval oval;              // OVAL timer callback
+            BL_ob oo;                  // Bluccino message object
+            int val;                   // transmitted value to OVAL callback
+            uint32_t due;              // due tick
+            uint32_t period;           // repeat period in ticks (0: single)
+            bool isr;                  // deliver in ISR context
+          } BL_stimer;
+
+    // init agregates for BL_stimer (thread or ISR delivery)
+
+  #define BL_STIMER(cb)      {oval:cb, oo:{_VOID,VOID_,0,NULL}, val:0, isr:false}
+  #define BL_STIMER_ISR(cb)  {oval:cb, oo:{_VOID,VOID_,0,NULL}, val:0, isr:true}
+
+//==============================================================================
+// software timer start/stop (same semantics as bl_timer())
+// - usage: static BL_stimer timer = BL_STIMER(module);
+//          bl_stimer(&timer,o,val,50); // start repeat timer @ 50 ms period
+//          bl_stimer(&timer,o,val,-8); // start single shot timer @ 8 ms later
+//          bl_stimer(&timer,o,val,0);  // stop timer and post stop message
+//          bl_stimer(&timer,NULL,0,0); // stop timer without stop message
+//==============================================================================
+
+  int bl_stimer(BL_stimer *p, BL_ob *o, int val, int ms);
+
 #endif // __BL_TIMER_H__
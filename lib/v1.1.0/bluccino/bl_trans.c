@@ -9,6 +9,40 @@
   #include "bluccino.h"
   #include "bl_trans.h"
 
+//==============================================================================
+// locals (network time)
+//==============================================================================
+
+  static BL_ms net_offset = 0;         // network time - local time
+  static bool net_synced = CFG_NETTIME_MASTER;  // master defines network time
+  static int net_syncs = 0;            // number of syncs
+  static int net_err = 0;              // last sync error (ms)
+
+//==============================================================================
+// network time lock
+// - the offset is written by the BT RX thread (time beacon) and read from any
+//   context; a 64-bit access is not atomic on 32-bit MCUs (torn reads)
+// - host builds (principle/mac_linux) are single threaded and need no lock
+//==============================================================================
+
+#ifdef __ZEPHYR__
+  static struct k_spinlock net_lock;
+
+  #define NET_LOCK()     k_spinlock_key_t key = k_spin_lock(&net_lock)
+  #define NET_UNLOCK()   k_spin_unlock(&net_lock,key)
+#else
+  #define NET_LOCK()     // empty
+  #define NET_UNLOCK()   // empty
+#endif
+
+  static BL_ms offset(void)            // consistent snapshot of net_offset
+  {
+    NET_LOCK();
+    BL_ms off = net_offset;
+    NET_UNLOCK();
+    return off;
+  }
+
 //==============================================================================
 // update transition
 // - usage: bl_trans(&trans,&update) // update a transition
@@ -64,3 +98,81 @@
 
     return 0;                          // default return value
   }
+
+//==============================================================================
+// network time
+//==============================================================================
+
+  BL_ms bl_net_ms(void)                // current network time
+  {
+    return bl_ms() + offset();
+  }
+
+  bool bl_net_synced(void)             // network time synced?
+  {
+    return net_synced;
+  }
+
+  BL_ms bl_net2ms(BL_ms net)           // network time to local time
+  {
+    return net - offset();
+  }
+
+//==============================================================================
+// sync network time with a time beacon
+// - net: network time at receipt of the beacon (hop latency compensated)
+// - first beacon (or error > CFG_NETTIME_STEP_MS) steps the offset, otherwise
+//   the offset slews by 1/4 of the error to filter relay jitter
+//==============================================================================
+
+  void bl_net_sync(BL_ms net)
+  {
+    if (CFG_NETTIME_MASTER)
+      return;                          // master is the network time source
+
+    BL_ms now = bl_ms();
+
+    NET_LOCK();
+    BL_ms err = net - (now + net_offset);
+
+    if (!net_synced || err > CFG_NETTIME_STEP_MS || err < -CFG_NETTIME_STEP_MS)
+      net_offset += err;               // step
+    else
+      net_offset += err / 4;           // slew
+
+    net_synced = true;
+    net_syncs++;
+    net_err = (int)err;
+    NET_UNLOCK();
+  }
+
+//==============================================================================
+// align a local begin time to the network time grid
+// - synced nodes receiving the same command at different relay hops (within
+//   one slot) will begin their transitions at the same network time
+//==============================================================================
+
+  BL_ms bl_net_align(BL_ms begin)
+  {
+  #if (CFG_NETTIME_SLOT_MS > 0)
+    if (!net_synced)
+      return begin;                    // no network time
+
+    BL_ms off = offset();
+    BL_ms net = begin + off;
+    net = (net + CFG_NETTIME_SLOT_MS - 1) / CFG_NETTIME_SLOT_MS;
+    return net * CFG_NETTIME_SLOT_MS - off;
+  #else
+    return begin;                      // no grid
+  #endif
+  }
+
+//==============================================================================
+// network time statistics
+//==============================================================================
+
+  void bl_net_stats(int *syncs, int *err)
+  {
+    if (syncs) *syncs = net_syncs;
+    if (err) *err = net_err;
+  }
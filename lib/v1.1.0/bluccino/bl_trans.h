@@ -9,6 +9,29 @@
 #ifndef __BL_TRANS_H__
 #define __BL_TRANS_H__
 
+//==============================================================================
+// network time config defaults
+// - CFG_NETTIME_MASTER: this node is the network time source (publishes
+//   a vendor time beacon every CFG_NETTIME_PERIOD seconds)
+// - CFG_NETTIME_SLOT_MS: transitions of synced nodes begin on this network
+//   time grid (0: off, transitions begin at local time of receipt)
+//==============================================================================
+
+  #ifndef CFG_NETTIME_MASTER
+    #define CFG_NETTIME_MASTER      0  // not the network time source
+  #endif
+  #ifndef CFG_NETTIME_PERIOD
+    #define CFG_NETTIME_PERIOD     10  // time beacon period (s)
+  #endif
+  #ifndef CFG_NETTIME_SLOT_MS
+    #define CFG_NETTIME_SLOT_MS     0  // transition start grid (ms), 0: off
+  #endif
+  #ifndef CFG_NETTIME_HOP_MS
+    #define CFG_NETTIME_HOP_MS     10  // beacon latency per relay hop (ms)
+  #endif
+  #ifndef CFG_NETTIME_STEP_MS
+    #define CFG_NETTIME_STEP_MS    50  // step (don't slew) above this error
+  #endif
 
 //==============================================================================
 // update transition
@@ -31,4 +54,22 @@
 
   int bl_fin(BL_trans *p);             // finish transition, return onetime true
 
+//==============================================================================
+// network time
+// - network time = local bl_ms() time + offset, offset learned from beacons
+// - usage: ms = bl_net_ms()            // current network time
+//          ok = bl_net_synced()        // did we get a time beacon yet?
+//          bl_net_sync(net)            // adjust offset (net time at receipt)
+//          local = bl_net2ms(net)      // convert network time to local time
+//          begin = bl_net_align(begin) // align local begin to network grid
+//          bl_net_stats(&syncs,&err)   // # of syncs and last error (ms)
+//==============================================================================
+
+  BL_ms bl_net_ms(void);               // current network time
+  bool bl_net_synced(void);            // network time synced?
+  void bl_net_sync(BL_ms net);         // sync network time with beacon
+  BL_ms bl_net2ms(BL_ms net);          // network time to local time
+  BL_ms bl_net_align(BL_ms begin);     // align local time to network grid
+  void bl_net_stats(int *syncs, int *err);
+
 #endif // __BL_TRANS_H__
@@ -102,6 +102,7 @@
   typedef int64_t BL_us;               // micro seconds
   typedef int64_t BL_ms;               // mili seconds
   typedef int64_t BL_sec;              // seconds
+  typedef uint64_t BL_cyc;             // hardware clock cycles
 
   typedef int *BL_pint;                // pointer to int (used in messages)
 
@@ -29,6 +29,7 @@
 //                  |       MESH:        | MESH lower interface
 // (B)->      PRV ->|       onoff        | provision on/off
 // (B)->      ATT ->|       onoff        | attention on/off
+// (B)->    READY ->|         1          | mesh & settings loaded, prov enabled
 //                  +--------------------+
 //                  |       RESET:       | RESET: public interface
 // (O)<-      DUE <-|                    | reset timer is due
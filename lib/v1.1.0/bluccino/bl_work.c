@@ -81,6 +81,182 @@
     return 0;
   }
 
+//==============================================================================
+// config defaults (shared Bluccino work queue thread)
+//==============================================================================
+
+  #ifndef CFG_WORKQ_STACK_SIZE
+    #define CFG_WORKQ_STACK_SIZE   1024     // stack size of Bluccino work queue
+  #endif
+
+  #ifndef CFG_WORKQ_PRIORITY
+    #define CFG_WORKQ_PRIORITY     5        // priority of Bluccino work queue
+  #endif
+
+//==============================================================================
+// helper: BL_workq worker - drain inbox in order
+//==============================================================================
+
+  static void qworker(struct k_work *w)
+  {
+    BL_workq *q = CONTAINER_OF(w,BL_workq,work);
+
+    for (;;)
+    {
+      k_spinlock_key_t key = k_spin_lock(&q->lock);
+
+      if (q->tail == q->head)          // inbox empty?
+      {
+        k_spin_unlock(&q->lock,key);
+        return;
+      }
+
+      BL_wqmsg m = q->inbox[q->tail & (q->size-1)];
+      q->tail++;
+      k_spin_unlock(&q->lock,key);
+
+      LOGO(5,"post queued work package to worker module",&m.oo,m.val);
+      q->oval(&m.oo,m.val);
+    }
+  }
+
+//==============================================================================
+// enqueue message to a BL_workq (return 0: OK, -ENOBUFS: dropped)
+// - usage: static BL_wqmsg inbox[4];
+//          static BL_workq wq = BL_WORKQ(module,inbox,true);
+//          bl_enqueue(&wq,o,val);     // thread or ISR context
+//==============================================================================
+
+  int bl_enqueue(BL_workq *q, BL_ob *o, int val)
+  {
+    int err = 0;
+    k_spinlock_key_t key = k_spin_lock(&q->lock);
+
+    if (!q->init)                      // init work structure on first use
+    {
+      __ASSERT((q->size & (q->size-1)) == 0, "inbox size must be power of 2");
+      k_work_init(&q->work, qworker);
+      q->init = true;
+    }
+
+    if (q->coalesce)                   // replace value of pending message?
+    {
+      for (uint32_t i = q->tail; i != q->head; i++)
+      {
+        BL_wqmsg *m = q->inbox + (i & (q->size-1));
+        if (bl_id(&m->oo) == bl_id(o) && m->oo.ix == o->ix)
+        {
+          m->oo = *o;  m->val = val;
+          q->coalesced++;
+          k_spin_unlock(&q->lock,key);
+          return 0;                    // pending work will deliver it
+        }
+      }
+    }
+
+    if (q->head - q->tail >= q->size)
+    {
+      q->dropped++;                    // inbox full => drop message
+      err = -ENOBUFS;
+    }
+    else
+    {
+      BL_wqmsg *m = q->inbox + (q->head & (q->size-1));
+      m->oo = *o;  m->val = val;
+      q->head++;
+      q->queued++;
+    }
+
+    k_spin_unlock(&q->lock,key);
+
+    if (err)
+      return err;
+
+    if (q->queue)
+      k_work_submit_to_queue(q->queue,&q->work);
+    else
+      k_work_submit(&q->work);
+    return 0;
+  }
+
+//==============================================================================
+// shared Bluccino work queue thread (started on first call)
+// - usage: wq.queue = bl_workq_thread();   // run worker on Bluccino thread
+//==============================================================================
+
+  K_THREAD_STACK_DEFINE(workq_stack, CFG_WORKQ_STACK_SIZE);
+
+  struct k_work_q *bl_workq_thread(void)
+  {
+    static struct k_work_q workq;
+    static bool started = false;
+
+    if (!started)
+    {
+      LOG(4,"start Bluccino work queue thread");
+      k_work_queue_init(&workq);
+      k_work_queue_start(&workq, workq_stack,
+                         K_THREAD_STACK_SIZEOF(workq_stack),
+                         CFG_WORKQ_PRIORITY, NULL);
+      started = true;
+    }
+    return &workq;
+  }
+
+//==============================================================================
+// helper: event ring drain worker - deliver captured ISR events in order
+//==============================================================================
+
+  static void drain(struct k_work *w)
+  {
+    BL_evring *r = CONTAINER_OF(w,BL_evring,work);
+    uint32_t tail = (uint32_t)atomic_get(&r->tail);
+
+    while (tail != (uint32_t)atomic_get(&r->head))
+    {
+      BL_evt e = r->buf[tail & (r->size-1)];     // copy event ...
+      atomic_set(&r->tail,(atomic_val_t)++tail); // ... and release slot
+
+      BL_ob oo = {r->oo.cl,r->oo.op,e.ix,&e};
+      LOGO(5,"deliver ISR event",&oo,e.val);
+      r->oval(&oo,e.val);
+    }
+  }
+
+//==============================================================================
+// post event from ISR to event ring (return 0: OK, -ENOBUFS: dropped)
+// - usage: static BL_evt buf[16];
+//          static BL_evring ring = BL_EVRING(module,_IO,STS_,buf);
+//          bl_isr_post(&ring,ix,val);      // capture event in ISR
+//==============================================================================
+
+  int bl_isr_post(BL_evring *r, int ix, int val)
+  {
+    uint32_t cyc = k_cycle_get_32();   // time stamp as early as possible
+
+    if (!r->init)                      // init work structure on first use
+    {
+      __ASSERT((r->size & (r->size-1)) == 0, "ring size must be power of 2");
+      k_work_init(&r->work, drain);
+      r->init = true;
+    }
+
+    uint32_t head = (uint32_t)atomic_get(&r->head);
+
+    if (head - (uint32_t)atomic_get(&r->tail) >= r->size)
+    {
+      atomic_inc(&r->drops);           // ring full => drop event
+      return -ENOBUFS;
+    }
+
+    BL_evt *e = r->buf + (head & (r->size-1));
+    e->ix = ix;  e->val = val;  e->cyc = cyc;
+
+    atomic_set(&r->head,(atomic_val_t)(head+1));  // publish event
+    k_work_submit(&r->work);
+    return 0;
+  }
+
 //==============================================================================
 // Bluccino work data structure and work processing in a thread
 // -usage: static BL_work work = BL_WORK(worker);
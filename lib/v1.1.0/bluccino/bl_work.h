@@ -15,6 +15,8 @@
 //   BL_work work = BL_WORK(worker);
 //   bl_submit(&work,o,val);           // submit work to execute immediately
 //   bl_schedule(&work,o,val,time);    // schedule work to execute @ time
+// - note: a pending message is overwritten by the next bl_submit(), use a
+//   BL_workq (see below) if messages must not get lost
 //==============================================================================
 
   typedef struct BL_work
@@ -37,6 +39,124 @@
 
   int bl_submit(BL_work *p, BL_ob *o, int val);
 
+//==============================================================================
+// Bluccino work queue: BL_work with a multi-slot inbox
+// - BL_work holds one message copy, so a second bl_submit() before the worker
+//   runs overwrites the pending message
+// - BL_workq keeps submitted messages in a small inbox ring (size power of 2)
+//   which the worker drains in order
+// - coalesce = true: a message with the same ID and @ix as a pending message
+//   replaces the pending message's value instead of taking a new slot
+// - queue: Zephyr work queue the worker runs on (NULL: system work queue),
+//   bl_workq_thread() provides a shared Bluccino work queue thread
+// - counters: queued, coalesced and dropped (inbox full) messages
+// - usage: static BL_wqmsg inbox[4];
+//          static BL_workq wq = BL_WORKQ(module,inbox,true);
+//          bl_enqueue(&wq,o,val);     // thread or ISR context
+//==============================================================================
+
+  typedef struct BL_wqmsg
+          {
+            BL_ob oo;                  // message object
+            int val;                   // message value
+          } BL_wqmsg;
+
+  typedef struct BL_workq
+          {
+            struct k_work work;        // Zephyr work structure
+            BL_oval oval;              // OVAL interface based worker
+            BL_wqmsg *inbox;           // inbox ring
+            uint32_t size;             // inbox size (power of 2)
+            bool coalesce;             // coalesce pending messages by ID
+            struct k_work_q *queue;    // work queue (NULL: system work queue)
+            bool init;                 // is work structure initialized?
+            struct k_spinlock lock;    // protects inbox (thread & ISR access)
+            uint32_t head;             // messages put into inbox
+            uint32_t tail;             // messages taken from inbox
+            uint32_t queued;           // counter: queued messages
+            uint32_t coalesced;        // counter: coalesced messages
+            uint32_t dropped;          // counter: dropped messages
+          } BL_workq;
+
+    // init aggregate for BL_workq
+
+  #define BL_WORKQ(module,buffer,coal)                                     \
+          {oval:module, inbox:buffer, size:BL_LEN(buffer), coalesce:coal,  \
+           queue:NULL, init:false}
+
+//==============================================================================
+// enqueue message to a BL_workq (return 0: OK, -ENOBUFS: dropped)
+// - usage: bl_enqueue(&wq,o,val)
+//==============================================================================
+
+  int bl_enqueue(BL_workq *q, BL_ob *o, int val);
+
+//==============================================================================
+// shared Bluccino work queue thread (started on first call)
+// - usage: wq.queue = bl_workq_thread();   // run worker on Bluccino thread
+//==============================================================================
+
+  struct k_work_q *bl_workq_thread(void);
+
+//==============================================================================
+// ISR event ring
+// - a BL_work package holds only one message copy, which is overwritten by
+//   each bl_submit(), so a burst of interrupts collapses into the last event
+// - an event ring captures every ISR event {ix,val,cyc} (cyc: hw cycle counter
+//   @ ISR time) and a worker delivers all events in order to the ring's module
+//   as message [cl:op @ix,<BL_evt>,val]
+// - lock free single producer (ISR) / single consumer (worker): the ISR only
+//   writes .head, the worker only writes .tail
+// - if the ring is full the event is dropped and counted in .drops
+// - usage: static BL_evt buf[16];    // number of entries must be power of 2
+//          static BL_evring ring = BL_EVRING(module,_IO,STS_,buf);
+//          bl_isr_post(&ring,ix,val);      // in ISR: capture event
+//          int drops = bl_drops(&ring);    // number of dropped events
+//==============================================================================
+
+  typedef struct BL_evt
+          {
+            int ix;                    // event index (e.g. pin instance)
+            int val;                   // event value (e.g. pin level)
+            uint32_t cyc;              // hw cycle counter @ ISR time
+          } BL_evt;
+
+  typedef struct BL_evring
+          {
+            struct k_work work;        // Zephyr work structure (drains ring)
+            BL_oval oval;              // module the events are posted to
+            BL_ob oo;                  // message ID of delivered events
+            BL_evt *buf;               // ring buffer
+            uint32_t size;             // ring size (power of 2)
+            bool init;                 // is work structure initialized?
+            atomic_t head;             // events captured (written by ISR)
+            atomic_t tail;             // events delivered (written by worker)
+            atomic_t drops;            // events dropped (ring full)
+          } BL_evring;
+
+    // init aggregate for BL_evring
+
+  #define BL_EVRING(module,cl,op,buffer)                                   \
+          {oval:module, oo:{cl,op,0,NULL}, buf:buffer, size:BL_LEN(buffer), \
+           init:false}
+
+//==============================================================================
+// post event from ISR to event ring (return 0: OK, -ENOBUFS: dropped)
+// - usage: bl_isr_post(&ring,ix,val)
+//==============================================================================
+
+  int bl_isr_post(BL_evring *r, int ix, int val);
+
+//==============================================================================
+// number of dropped events of an event ring
+// - usage: int drops = bl_drops(&ring)
+//==============================================================================
+
+  static inline int bl_drops(BL_evring *r)
+  {
+    return (int)atomic_get(&r->drops);
+  }
+
 //==============================================================================
 // definition of Bluccino semaphore structure
 //==============================================================================
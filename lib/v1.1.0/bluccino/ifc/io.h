@@ -36,6 +36,8 @@
 //                  |         IO:        | IO input interface
 //            GET --|         ix         | get I/O value
 //            SET --|       ix,val       | set I/O value
+//        SETMASK --|     @mask,bits     | set masked outputs (1 write/port)
+//        GETPORT --|       @mask        | get masked inputs (1 read/port)
 //         DEVICE --|     @ix,&<GP_dev>  | retrieve I/O device pointer
 //         ATTACH --|   @ix,(isr),flags  | attach interrupt service routine
 //                  +--------------------+
@@ -51,6 +53,16 @@
     public: Io_Set(int ix, int val) : BlMsg(_IO,SET_,ix,NULL,val) {}
   };
 
+  class Io_SetMask : public BlMsg
+  {
+    public: Io_SetMask(int mask, int bits) : BlMsg(_IO,SETMASK_,mask,NULL,bits) {}
+  };
+
+  class Io_GetPort : public BlMsg
+  {
+    public: Io_GetPort(int mask) : BlMsg(_IO,GETPORT_,mask,NULL,0) {}
+  };
+
   class Io_Device : public BlMsg
   {
     public: Io_Device(int ix, GP_dev **dev) : BlMsg(_IO,DEVICE_,ix,dev,0) {}
@@ -70,6 +82,8 @@
     public:
       virtual int IO_GET(int ix) { return BL_VOID2; }
       virtual int IO_SET(int ix, int val) { return BL_VOID2; }
+      virtual int IO_SETMASK(int mask, int bits) { return BL_VOID2; }
+      virtual int IO_GETPORT(int mask) { return BL_VOID2; }
       virtual int IO_DEVICE(int ix, GP_dev **dev) { return BL_VOID2; }
       virtual int IO_ATTACH(int ix, BlMod &isr, int flags) { return BL_VOID2; }
 
@@ -81,6 +95,8 @@
         {
           case GET_: return IO_GET(msg.ix);
           case SET_: return IO_SET(msg.ix, msg.val);
+          case SETMASK_: return IO_SETMASK(msg.ix, msg.val);
+          case GETPORT_: return IO_GETPORT(msg.ix);
           case DEVICE_: return IO_DEVICE(msg.ix, (GP_dev**)msg.data);
           case ATTACH_: return IO_ATTACH(msg.ix, *((BlMod*)msg.data), msg.val);
           default: return BL_VOID1;
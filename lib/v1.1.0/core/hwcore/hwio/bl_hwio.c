@@ -40,6 +40,15 @@
   static IO_cfg config[CFG_MAX_GPIO_PINS];  // pin configuration table
   static int count = -1;                    //  current pin count
 
+//==============================================================================
+// ISR event ring
+// - every pin interrupt (without private ISR) is captured with pin level and
+//   cycle time stamp, and delivered in order as [#IO:STS @ix,<BL_evt>,val]
+//==============================================================================
+
+  static BL_evt events[CFG_IO_EVENTS];      // ISR event ring buffer
+  static BL_evring ring = BL_EVRING(PMI,BL_AUG(_IO),STS_,events);
+
 //==============================================================================
 // helper: reset I/O configuration table
 // - usage: cnt = reset(false)    // cond. resets GPIO pin table (if never init)
@@ -69,7 +78,8 @@
 // ISR: provide pin ISR callback
 // - use `ctx` pointer to reconstruct config entry index `ix`
 // - from `ix` construct pointer `cfg` to config entry
-// - if ISR has been provided then call
+// - if ISR has been provided then call, otherwise capture the event in the
+//   ISR event ring (delivered by a worker as [#IO:STS @ix,<BL_evt>,val])
 //==============================================================================
 
   static inline IO_cfg *resolve(GP_ctx *ctx)
@@ -86,7 +96,7 @@
     if (cfg->isr)
       cfg->isr(&cfg->oo,val);          // emit event message (ISR)
     else
-      _bl_pmi(_IO,ISR_, (cfg-config),cfg->module,val);  // ISR to submit work
+      bl_isr_post(&ring,(cfg-config),val);  // capture event for worker
   }
 
 //==============================================================================
@@ -257,6 +267,153 @@
     return 0;
   }
 
+//==============================================================================
+// helper: port groups for masked multi-pin access
+// - collect the pin instances selected by a mask into (at most one) group per
+//   port, each group holding the port's raw pin mask
+// - usage: n = port_groups(mask,group)  // n < 0: error
+//==============================================================================
+
+  typedef struct IO_grp
+          {
+            GP_dev *port;                   // GPIO port device
+            GP_pins pins;                   // raw pin mask on this port
+            GP_pins actlow;                 // active low pins of .pins
+          } IO_grp;
+
+  static int port_groups(int mask, IO_grp *group)
+  {
+    int n = 0;                              // number of port groups
+
+    if (count < 0)
+      return bl_err(-ENODEV,"bl_hwio not initialized");
+
+    if (count < 32 && (mask & ~((1u << count) - 1)))
+      return bl_err(-1,"bad pin instance mask");
+
+    for (int ix=0; ix < count; ix++)
+    {
+      if (!(mask & (1 << ix)))
+        continue;
+
+      GP_io *io = &config[ix].pin.io;
+      int k = 0;
+
+      while (k < n && group[k].port != io->port)
+        k++;                                // find group of pin's port
+
+      if (k == n)                           // new port group
+      {
+        group[n].port = io->port;
+        group[n].pins = group[n].actlow = 0;
+        n++;
+      }
+
+      group[k].pins |= BIT(io->pin);
+      if (config[ix].flags & GPIO_ACTIVE_LOW)
+        group[k].actlow |= BIT(io->pin);
+    }
+    return n;
+  }
+
+//==============================================================================
+// handler: [IO:SETMASK @mask,bits] // set several outputs with one port write
+// - @mask: bit mask of pin instance indices (bit ix selects pin instance ix)
+// - bits: logical output values (bit ix for pin instance ix)
+// - all selected pins of the same port are written by a single masked raw
+//   port write (active low pins are inverted before the write)
+//==============================================================================
+
+  static int io_setmask(BL_ob *o, int val)
+  {
+    IO_grp group[CFG_MAX_GPIO_PINS];
+    int mask = bl_ix(o);
+    int n = port_groups(mask,group);
+    if (n < 0) return n;
+
+    LOG(5,"bl_hwio << [IO:SETMASK @0x%X,0x%X] (%d port%s)",
+        mask,val, n, n==1?"":"s");
+
+      // translate logical instance bits to raw port values
+
+    GP_pins value[CFG_MAX_GPIO_PINS] = {0};
+
+    for (int ix=0; ix < count; ix++)
+    {
+      if (!(mask & (1 << ix)))
+        continue;
+
+      IO_cfg *cfg = config + ix;
+      GP_io *io = &cfg->pin.io;
+      int k = 0;
+
+      while (group[k].port != io->port)
+        k++;                                // port group of pin instance
+
+      if (val & (1 << ix))
+        value[k] |= BIT(io->pin);
+
+      if (cfg->flags & BL_DIGOUT)
+        cfg->val = ((val >> ix) & 1);       // update read back value
+    }
+
+    int err = 0;                            // first error (all ports written)
+    for (int k=0; k < n; k++)
+    {
+      GP_pins raw = value[k] ^ group[k].actlow;
+      int rv = gpio_port_set_masked_raw(group[k].port,group[k].pins,raw);
+      if (rv < 0 && err == 0)
+        err = rv;
+    }
+    return err;
+  }
+
+//==============================================================================
+// handler: [IO:GETPORT @mask] // read several pins with one read per port
+// - @mask: bit mask of pin instance indices (bit ix selects pin instance ix)
+// - return: logical pin values (bit ix for pin instance ix), or < 0 on error
+// - like [IO:GET] outputs report their read back value
+//==============================================================================
+
+  static int io_getport(BL_ob *o, int val)
+  {
+    IO_grp group[CFG_MAX_GPIO_PINS];
+    int mask = bl_ix(o);
+    int n = port_groups(mask,group);
+    if (n < 0) return n;
+
+    GP_pins value[CFG_MAX_GPIO_PINS];
+
+    for (int k=0; k < n; k++)
+    {
+      int err = gpio_port_get_raw(group[k].port,value+k);
+      if (err) return err;
+      value[k] ^= group[k].actlow;          // raw -> logical values
+    }
+
+    int bits = 0;
+    for (int ix=0; ix < count; ix++)
+    {
+      if (!(mask & (1 << ix)))
+        continue;
+
+      IO_cfg *cfg = config + ix;
+      GP_io *io = &cfg->pin.io;
+      int k = 0;
+
+      while (group[k].port != io->port)
+        k++;                                // port group of pin instance
+
+      if (cfg->flags & BL_DIGOUT)
+        bits |= (cfg->val ? 1 : 0) << ix;   // read back value
+      else if (value[k] & BIT(io->pin))
+        bits |= (1 << ix);
+    }
+
+    LOG(5,BL_C "bl_hwio << [IO:GETPORT @0x%X] = 0x%X",mask,bits);
+    return bits;
+  }
+
 //==============================================================================
 // handler: [IO:DEVICE @ix,&<GP_dev>]  // retrieve I/O device pointer
 //==============================================================================
@@ -337,20 +494,20 @@
 //                  |         IO:        | IO input interface
 // (D)->      GET ->|         @ix        | digital or analog get
 // (D)->      SET ->|      @ix,val       | digital or analog set
+// (D)->  SETMASK ->|     @mask,bits     | set masked outputs (1 write/port)
+// (D)->  GETPORT ->|       @mask        | get masked inputs (1 read/port)
 // (D)->   DEVICE ->|     @ix,&<GP_dev>  | retrieve I/O device pointer
 // (D)->   ATTACH ->|  @ix,&(isr),flags  | attach interrupt service routine
+// (D)->    COUNT ->|                    | number of dropped ISR events
 //                  |....................|
 //                  |         IO:        | IO output interface
-//            ISR --|       @ix,sts      | offload from ISR by submitting work
-// (U)<-      STS <-|       @ix,sts      | notify pin level change
+// (U)<-      STS <-|   @ix,<BL_evt>,sts | notify pin level change (in order)
 //                  +--------------------+
 //
 //==============================================================================
 
   int bl_hwio(BL_ob *o, int val)
   {
-    static BL_work work = BL_WORK(PMI);   // worker calls PMI
-    static BL_ob oo = BL_OB(BL_AUG(_IO),STS_, 0,NULL);
     static BL_oval U = NULL;              // most likely up gear
 
     switch (bl_id(o))
@@ -364,13 +521,14 @@
       case BL_ID(_DIGITAL,OUTPUT_): return digital_output(o,val);
       case BL_ID(_IO,GET_):         return io_get(o,val);
       case BL_ID(_IO,SET_):         return io_set(o,val);
+      case BL_ID(_IO,SETMASK_):     return io_setmask(o,val);
+      case BL_ID(_IO,GETPORT_):     return io_getport(o,val);
       case BL_ID(_IO,DEVICE_):      return io_device(o,val);
       case BL_ID(_IO,ATTACH_):      return io_attach(o,val);
 
+      case BL_ID(_IO,COUNT_):       return bl_drops(&ring);
+
       case _BL_ID(_IO,STS_):        return bl_out(o,val,(U));
-      case _BL_ID(_IO,ISR_):
-        bl_set_ix(&oo,bl_ix(o));      // update current I/O index
-        return bl_submit(&work,&oo,val);
       default:                      return BL_VOID;
     }
   }
@@ -43,6 +43,16 @@ extern "C"
     return bl_msg((bl_hwio), _IO,SET_, ix,NULL,val);
   }
 
+	int BlHwio::IO_SETMASK(int mask, int bits)
+  {
+    return bl_msg((bl_hwio), _IO,SETMASK_, mask,NULL,bits);
+  }
+
+	int BlHwio::IO_GETPORT(int mask)
+  {
+    return bl_msg((bl_hwio), _IO,GETPORT_, mask,NULL,0);
+  }
+
 	int BlHwio::IO_DEVICE(int ix, GP_dev **pdev)
   {
     return bl_msg((bl_hwio), _IO,DEVICE_, ix,pdev,0);
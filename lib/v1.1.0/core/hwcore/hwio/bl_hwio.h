@@ -46,6 +46,14 @@
     #define CFG_MAX_GPIO_PINS      10       // max 10 pin definitions by default
   #endif
 
+  #if (CFG_MAX_GPIO_PINS > 31)
+    #error CFG_MAX_GPIO_PINS // must not exceed 31 (IO:SETMASK/GETPORT masks)
+  #endif
+
+  #ifndef CFG_IO_EVENTS
+    #define CFG_IO_EVENTS          16       // ISR event ring size (power of 2)
+  #endif
+
   #ifndef CFG_PORT0_LABEL
     #define CFG_PORT0_LABEL   "GPIO_0"      // used by nRF52832 DK, nRF52840 DK
   #endif
@@ -138,6 +146,41 @@
     return _bl_msg((to), _IO,SET_, pin,NULL,val);
   }
 
+//==================================================================================================
+// syntactic sugar: set several outputs at once (message sent to down gear)
+// - usage: err = bl_iosetmask(mask,bits)        // set pins selected by mask
+// -        err = _bl_iosetmask(mask,bits,(PMI)) // augmented form
+// - mask: bit ix selects pin instance ix, bits: bit ix is value of instance ix
+// - pins on the same port are written with a single masked port write
+//==================================================================================================
+
+  static inline int bl_iosetmask(int mask, int bits)
+  {
+    return bl_msg((bl_down), _IO,SETMASK_, mask,NULL,bits);
+  }
+
+  static inline int _bl_iosetmask(int mask, int bits, BL_oval to)
+  {
+    return _bl_msg((to), _IO,SETMASK_, mask,NULL,bits);
+  }
+
+//==================================================================================================
+// syntactic sugar: get several pins at once (message sent to down gear)
+// - usage: bits = bl_iogetport(mask)            // get pins selected by mask
+// -        bits = _bl_iogetport(mask,(PMI))     // augmented form
+// - returns bit ix = value of pin instance ix (one port read per port)
+//==================================================================================================
+
+  static inline int bl_iogetport(int mask)
+  {
+    return bl_msg((bl_down), _IO,GETPORT_, mask,NULL,0);
+  }
+
+  static inline int _bl_iogetport(int mask, BL_oval to)
+  {
+    return _bl_msg((to), _IO,GETPORT_, mask,NULL,0);
+  }
+
 //==================================================================================================
 // syntactic sugar: attach ISR (interrupt service routine) to input pin
 // - usage: bl_attach(ix,isr,flags)                // attach isr to pin @ix
@@ -194,6 +237,8 @@
       BlIo &IO = *this;                //                |         IO:        | IO input interface
       In IO_GET(int ix);               // (D)->    GET ->|         ix         | get I/O value
       In IO_SET(int ix, int val);      // (D)->    SET ->|       ix,val       | set I/O value
+      In IO_SETMASK(int mask,int bits);// (D)->SETMASK ->|     @mask,bits     | set masked outputs
+      In IO_GETPORT(int mask);         // (D)->GETPORT ->|       @mask        | get masked inputs
       In IO_DEVICE(int ix,GP_dev **d); // (D)-> DEVICE ->|     @ix,&<GP_dev>  | retrieve I/O device
       In IO_ATTACH(int ix,BlMod &isr,  // (D)-> ATTACH --|   @ix,(isr),flags  | attach interrupt
                    int flags);         //                |                    |
@@ -215,6 +215,13 @@
   #include "bl_clean.h"
   #undef sys_init
 
+  #define sys_init  sys_init_key
+  #define isr       isr_key
+  #include "bl_hwkey.c"                // key matrix driver
+  #include "bl_clean.h"
+  #undef sys_init
+  #undef isr
+
   #define sys_init  sys_init_led
   #include "bl_hwled.c"                // LED core driver
   #include "bl_clean.h"
@@ -258,10 +265,14 @@
 //                  |        LED:        | LED: input interface
 // (D)->      SET ->|      @ix,onoff     | set LED @ix on/off (i=0..4)
 // (D)->   TOGGLE ->|                    | toggle LED @ix (i=0..4)
+// (D)->    LEVEL ->|     @ix,level      | set LED @ix brightness (0..100)
+// (D)->    BLINK ->|  @ix,"pattern",ms  | run LED @ix animation
 //                  |....................|
 //                  |        LED:        | LED: output interface
 // (L)<-      SET <-|      @ix,onoff     | set LED @ix on/off (i=0..4)
 // (L)<-   TOGGLE <-|                    | toggle LED @ix (i=0..4)
+// (L)<-    LEVEL <-|     @ix,level      | set LED @ix brightness (0..100)
+// (L)<-    BLINK <-|  @ix,"pattern",ms  | run LED @ix animation
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON input interface
 // (B)->    PRESS ->|        @ix,1       | button @ix pressed (rising edge)
@@ -270,6 +281,7 @@
 // (B)->     HOLD ->|       @ix,time     | button @ix held (time: hold time)
 // (D)->      CFG ->|        mask        | config button event mask
 // (D)->       MS ->|         ms         | set click/hold discrimination time
+// (D)->    COUNT ->|                    | number of dropped ISR edge events
 //                  |....................|
 //                  |       BUTTON:      | BUTTON output interface
 // (U)<-    PRESS <-|        @ix,0       | button @ix pressed (rising edge)
@@ -288,6 +300,7 @@
 //                  |        NVM:        | NVM input interface
 // (D)->     LOAD ->|      <BL_nvm>      | load NVM data
 // (D)->     SAVE ->|      <BL_nvm>      | save NVM data
+// (D)->    FLUSH ->|                    | flush pending NVM data to flash
 // (D)->      CFG ->|                    | is NVM configured (available)?
 //                  +--------------------+
 //
@@ -320,6 +333,8 @@
 
       case LED_SET_ix_0_onoff:
       case LED_TOGGLE_ix_0_0:
+      case LED_LEVEL_ix_0_level:
+      case LED_BLINK_ix_pat_ms:
         return bl_fwd(o,val,(L));      // forward to LED driver module
 
       case BUTTON_PRESS_ix_0_0:
@@ -331,12 +346,14 @@
 
       case BUTTON_CFG_0_0_mask:
       case BUTTON_MS_0_0_ms:
+      case BL_ID(_BUTTON,COUNT_):
         return bl_fwd(o,val,(B));      // config bl_hwbut module
 
       case NVM_LOAD_0_BL_tray_0:
       case NVM_SAVE_0_BL_tray_0:
       case NVM_STORE_ix_0_val:
       case NVM_RECALL_ix_0_0:
+      case NVM_FLUSH_0_0_0:
       case NVM_SUPPORT_0_0_0:
         return bl_fwd(o,val,(N));      // forward to bl_hwnvm module
 
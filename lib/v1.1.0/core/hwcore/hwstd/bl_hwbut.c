@@ -11,6 +11,7 @@
   #include "bluccino.h"
   #include "bl_hw.h"
   #include "bl_hwbut.h"
+  #include "bl_hwkey.h"
   #include "bl_gpio.h"
 
 //==============================================================================
@@ -33,6 +34,10 @@
     #define CFG_DEBUG_DEBOUNCING 0     // no debouncing debug by default
   #endif
 
+  #ifndef CFG_BUTTON_EVENTS
+    #define CFG_BUTTON_EVENTS   16     // ISR edge ring size (power of 2)
+  #endif
+
 //==============================================================================
 // Get button configuration from the devicetree sw0 alias. This is mandatory.
 //==============================================================================
@@ -73,6 +78,7 @@
   #endif
 
   #define NBUT (BUTTON1_OK + BUTTON2_OK + BUTTON3_OK + BUTTON4_OK)
+  #define NBTN (NBUT + NKEY)           // GPIO buttons plus matrix keys
 
 //==============================================================================
 // Define a BL_button data structure per each button. We need:
@@ -91,6 +97,7 @@
             BL_byte pulses;            // number of second-pulses
             const GP_ds ds;            // button pin device spec
             GP_ctx context;            // button context (to assign IRS handler)
+            struct k_work_delayable timer;  // one-shot timer for next deadline
           } BL_button;
 
     // initializer for BL_button variables
@@ -106,7 +113,10 @@
             .ds=GP_IO(nid,gpios,{0}),  \
           }
 
-   BL_button button[NBUT] =
+    // matrix keys (@NBUT+1 .. @NBTN) follow the GPIO buttons and get their
+    // @ix assigned at init; their GPIO fields remain unused
+
+   BL_button button[NBTN] =
              {
                #if (BUTTON1_OK)
                  BL_BUTTON(1,BUTTON1),   // button @1
@@ -163,7 +173,7 @@
     int ix = bl_ix(o);                 // short hand for @ix
     BL_ms now = bl_ms();
 
-    if (ix < 0 || ix > NBUT)
+    if (ix < 1 || ix > NBTN)
       return -1;                       // bad args
 
     BL_button *p = button + (ix-1);
@@ -214,6 +224,102 @@
     }
   }
 
+//==============================================================================
+// timing: evaluate hold, multi-click and pulse timing of a button
+// - formerly done for all buttons by each [SYS:TICK], now invoked by the
+//   button's one-shot timer exactly when the next deadline is due
+//==============================================================================
+
+  static void timing(BL_button *p, BL_ms now)
+  {
+    int held = now - p->time;          // hold time
+
+    if ( p->time )
+    {
+      if ( held >= T_hold && !p->hold && p->state)
+      {
+        p->hold = true;                // button @ix entered HOLD state
+        if ((mask & BL_HOLD) && p->clicks <= 1)
+        {
+          LOG(5,BL_Y "button hold (begin)");
+          _bl_pmi(_BUTTON,HOLD_,p->ix,NULL,0);
+          p->pulses++;
+        }
+        else if ((mask & BL_CLICK) && p->clicks > 1)
+        {
+          LOG(4,BL_B "button click-hold event");
+          _bl_pmi(_BUTTON,CLICK_, p->ix,NULL,-(p->clicks));
+          reset(p);
+        }
+      }
+      else if ( held >= T_multi && !p->hold && !p->state && p->clicks)
+      {
+        if (mask & BL_CLICK && p->clicks > 0)
+        {
+          LOG(5,BL_B "button clicked %d times (end)",p->clicks);
+          _bl_pmi(_BUTTON,CLICK_,p->ix,NULL,p->clicks);
+        }
+        p->clicks = 0;                 // clear button click counter
+      }
+
+      if ( held > T_hold && p->state == 0)
+        reset(p);  // clear press time & hold state
+    }
+
+    if (mask & BL_TOCK && p->hold && p->clicks <= 1)
+    {
+      int tocktime = 1000 * p->pulses;
+      if ( now >= p->time + tocktime )
+      {
+        LOG(5,BL_B "button pulse %d ms",p->clicks);
+        _bl_pmi(_BUTTON,TOCK_,p->ix,NULL,p->pulses);
+        p->pulses++;
+      }
+    }
+  }
+
+//==============================================================================
+// arm the button's one-shot timer for the next timing deadline (if any)
+// - an idle button has no deadline, thus costs no CPU at all
+//==============================================================================
+
+  static void arm(BL_button *p, BL_ms now)
+  {
+    BL_ms due = 0;                     // 0: no deadline
+
+    #define DUE(t)  (due = (due == 0 || (t) < due) ? (t) : due)
+
+    if (p->time)
+    {
+      if (!p->hold && p->state)
+        DUE(p->time + T_hold);         // hold begin
+      if (!p->hold && !p->state && p->clicks)
+        DUE(p->time + T_multi);        // end of multi click
+      if (!p->state)
+        DUE(p->time + T_hold + 1);     // reset after release
+    }
+
+    if (mask & BL_TOCK && p->hold && p->clicks <= 1)
+      DUE(p->time + 1000 * p->pulses); // next pulse
+
+    #undef DUE
+
+    if (due)
+      k_work_reschedule(&p->timer, K_MSEC(BL_MAX(due-now,0)));
+    else
+      k_work_cancel_delayable(&p->timer);
+  }
+
+  static void timer_expired(struct k_work *work)
+  {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    BL_button *p = CONTAINER_OF(dwork,BL_button,timer);
+    BL_ms now = bl_ms();
+
+    timing(p,now);
+    arm(p,now);                        // re-arm for next deadline
+  }
+
 //==============================================================================
 // button worker - posts [BUTTON:PRESS @ix 1] or [BUTTON:RELEASE @ix 0]
 // - ISR routine sets `id` (button ID) and `debounced` (debounced button state)
@@ -250,6 +356,8 @@
 
       bl_msg((C), _BUTTON,RELEASE_, p->ix,NULL,dt);
     }
+
+    arm(p,bl_ms());                    // deadlines have changed
   }
 
 //==============================================================================
@@ -270,6 +378,25 @@
 
   K_WORK_DELAYABLE_DEFINE(cooldown_work, cooldown_expired);
 
+//==============================================================================
+// edge handler: [BUTTON:STS @ix,<BL_evt>,level] (from ISR edge ring)
+// - every edge is captured by the ISR with its cycle time stamp and delivered
+//   in order, the debounce cool time is counted from the edge's time stamp
+//==============================================================================
+
+  static int edge(BL_ob *o, int val)
+  {
+    BL_evt *e = (BL_evt*)bl_data(o);
+    int age = (int)k_cyc_to_ms_floor32(k_cycle_get_32() - e->cyc);
+
+    LOG(5,"button @%d edge -> %d (%d ms ago)",bl_ix(o),val,age);
+    k_work_reschedule(&cooldown_work, K_MSEC(BL_MAX(MS_COOLDOWN-age,0)));
+    return 0;
+  }
+
+  static BL_evt edges[CFG_BUTTON_EVENTS];   // ISR edge ring buffer
+  static BL_evring ring = BL_EVRING(edge,_BUTTON,STS_,edges);
+
 //==============================================================================
 // provide button ISR callback (button pressed/released)
 //==============================================================================
@@ -277,9 +404,7 @@
   static void isr(GP_dev *dev, GP_ctx *ctx, GP_pins pins)
   {
     BL_button *p = CONTAINER_OF(ctx,BL_button,context);
-
-    LOG(5,"button ISR, pin @%d (mask:0x%04x)",p->ix,pins);
-    k_work_reschedule(&cooldown_work, K_MSEC(MS_COOLDOWN));
+    bl_isr_post(&ring, p->ix, gpio_pin_get_dt(&p->ds));
   }
 
 //==============================================================================
@@ -298,6 +423,8 @@
 
     LOG(5,"set up button @%d (%s, pin %d)", p->ix, p->ds.port->name, p->ds.pin);
 
+    k_work_init_delayable(&p->timer, timer_expired);
+
     gp_pin_cfg(&p->ds, GPIO_INPUT);
     gp_int_cfg(&p->ds, GPIO_INT_EDGE_BOTH);
     gp_add_cb(&p->ds, &p->context, isr);
@@ -305,67 +432,6 @@
     return 0;
   }
 
-//==============================================================================
-// worker: ticking
-//==============================================================================
-
-  static int sys_tick(BL_ob *o, int val)
-  {
-    BL_ms now = bl_ms();
-
-    for (int i=0; i < NBUT; i++)
-    {
-      BL_button *p = button + i;
-      int held = now - p->time;     // hold time
-
-      if ( p->time )
-      {
-        if ( held >= T_hold && !p->hold && p->state)
-        {
-          p->hold = true;             // button @(i+1) entered HOLD state
-	   		  if ((mask & BL_HOLD) && p->clicks <= 1)
-				  {
-            LOG(5,BL_Y "button hold (begin)");
-            _bl_pmi(_BUTTON,HOLD_,p->ix,NULL,0);
-            p->pulses++;
-				  }
-          else if ((mask & BL_CLICK) && p->clicks > 1)
-          {
-            LOG(4,BL_B "button click-hold event");
-            _bl_pmi(_BUTTON,CLICK_, bl_ix(o),NULL,-(p->clicks));
-            reset(p);
-          }
-        }
-        else if ( held >= T_multi && !p->hold && !p->state && p->clicks)
-        {
-	  		  if (mask & BL_CLICK && p->clicks > 0)
-				  {
-            LOG(5,BL_B "button clicked %d times (end)",p->clicks);
-            _bl_pmi(_BUTTON,CLICK_,p->ix,NULL,p->clicks);
-			    }
-          p->clicks = 0;             // clear button click counter
-          // LOG(5,BL_G "clicks:%d", p->clicks);
-        }
-
-        if ( held > T_hold && p->state == 0)
-          reset(p);  // clear press time & hold state
-      }
-
-      if (mask & BL_TOCK && p->hold && p->clicks <= 1)
-      {
-        int tocktime = 1000 * p->pulses;
-        if ( now >= p->time + tocktime )
-        {
-          LOG(5,BL_B "button pulse %d ms",p->clicks);
-          _bl_pmi(_BUTTON,TOCK_,p->ix,NULL,p->pulses);
-          p->pulses++;
-        }
-      }
-    }
-
-    return 0;                      // OK
-  }
-
 //==============================================================================
 // worker: init module
 //==============================================================================
@@ -377,7 +443,13 @@
     for (int i=1; i <= NBUT; i++)
       config(i);
 
-    return 0;
+    for (int i=NBUT+1; i <= NBTN; i++) // matrix keys
+    {
+      button[i-1].ix = i;
+      k_work_init_delayable(&button[i-1].timer, timer_expired);
+    }
+
+    return bl_init(bl_hwkey,bl_hwbut); // key matrix output => bl_hwbut
   }
 
 //==============================================================================
@@ -385,13 +457,17 @@
 //==============================================================================
 //
 // (!) := (<parent>);  (#) := (bl_hwbut);  (U) := (bl_up);  (D) := (bl_down);
+// (K) := (bl_hwkey);
 //
 //                  +--------------------+
 //                  |      bl_hwbut      | module bl_hwbut
 //                  +--------------------+
 //                  |        SYS:        | SYS interface
 // (!)->     INIT ->|       <out>        | init module, ignore <out> callback
-// (!)->     TICK ->|       @ix,cnt      | tick module
+// (!)->     TICK ->|       @ix,cnt      | ignored (timing is event driven)
+//                  +--------------------+
+//                  |       BUTTON:      | BUTTON input interface
+// (K)->      STS ->|       @k,sts       | debounced matrix key @k state
 //                  +--------------------+
 //                  |       BUTTON:      | BUTTON output interface
 // (U)<-    PRESS <-|        @ix,0       | button press at time 0
@@ -401,6 +477,7 @@
 // (U)<-     TOCK <-|       @ix,ms       | button tock event, every 1000 ms
 // (!)->      CFG ->|        mask        | config button event mask
 // (!)->       MS ->|         ms         | set click/hold discrimination time
+// (!)->    COUNT ->|                    | number of dropped ISR edge events
 //                  +--------------------+
 //                  |       SWITCH:      | SWITCH interface
 // (U)<-      STS <-|       @ix,sts      | emit status of toggle switch event
@@ -422,7 +499,13 @@
       	return sys_init(o,val);           // delegate to sys_init() worker
 
       case BL_ID(_SYS,TICK_):
-      	return sys_tick(o,val);           // delegate to sys_tick() worker
+      	return 0;                         // OK (button timers do the timing)
+
+      case BL_ID(_BUTTON,STS_):           // matrix key @k => button @NBUT+k
+        if (bl_ix(o) < 1 || bl_ix(o) > NKEY)
+          return -1;                      // bad key index
+        state_change(button + NBUT + bl_ix(o) - 1, val);
+        return 0;                         // OK
 
       case BL_ID(_BUTTON,CFG_):
 			  mask = (BL_word)val;              // store event mask
@@ -432,6 +515,9 @@
 			  T_hold = T_multi = val;           // store grace time
       	return 0;                         // OK
 
+      case BL_ID(_BUTTON,COUNT_):         // dropped ISR edge events
+      	return bl_drops(&ring);
+
       case _BL_ID(_BUTTON,PRESS_):
       case _BL_ID(_BUTTON,RELEASE_):
       case _BL_ID(_BUTTON,CLICK_):
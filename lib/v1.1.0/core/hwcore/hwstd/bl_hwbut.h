@@ -8,6 +8,8 @@
 // BUTTON interface
 // - button presses notify with [BUTTON:PRESS @ix 1] with @ix = 1..4
 // - button releases notify with [BUTTON:RELEASE @ix 0] with @ix = 1..4
+// - keys of a scanned key matrix (bl_hwkey) follow the GPIO buttons with
+//   @ix = NBUT+1 .. NBUT+NKEY and run through the same click/hold logic
 //
 // SWITCH interface
 // - each button (1..4) is assigned with a logical switch which is toggled
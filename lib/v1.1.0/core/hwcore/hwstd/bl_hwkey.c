@@ -0,0 +1,214 @@
+//==============================================================================
+// bl_hwkey.c
+// Bluccino key matrix driver (scanned keypad)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+// - all keys are sampled into one 64 bit word per scan and debounced at once
+//   with 2-bit vertical counters: a key's state toggles after 4 consecutive
+//   equal samples, independent of the number of keys
+// - while no key is pressed (and nothing is being debounced) scanning stops:
+//   all columns are driven and any row interrupt restarts the scan
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_hw.h"
+  #include "bl_hwkey.h"
+  #include "bl_gpio.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO "bl_hwkey"          // who is logging
+
+  #define LOG                     LOG_BUTTON
+  #define LOGO(lvl,col,o,val)     LOGO_BUTTON(lvl,col WHO ":",o,val)
+
+  #define PMI  bl_hwkey           // public module interface
+
+#if (NKEY > 0)
+//==============================================================================
+// locals
+//==============================================================================
+
+  #define KEY_DS(nid,prop,i)   GPIO_DT_SPEC_GET_BY_IDX(nid,prop,i)
+
+  static const GP_ds rows[NROW] =
+         { DT_FOREACH_PROP_ELEM_SEP(KEYPAD, row_gpios, KEY_DS, (,)) };
+  static const GP_ds cols[NCOL] =
+         { DT_FOREACH_PROP_ELEM_SEP(KEYPAD, col_gpios, KEY_DS, (,)) };
+
+  static GP_ctx row_ctx[NROW];         // row interrupt contexts
+
+  static uint64_t state = 0;           // debounced key states
+  static uint64_t cnt0 = 0, cnt1 = 0;  // vertical counter (bit 0, bit 1)
+
+//==============================================================================
+// sample all keys (one column at a time)
+//==============================================================================
+
+  static uint64_t sample(void)
+  {
+    uint64_t keys = 0;
+
+    for (int c=0; c < NCOL; c++)
+    {
+      gp_pin_set(cols+c,1);            // drive column active
+      for (int r=0; r < NROW; r++)
+        if (gp_pin_get(rows+r) > 0)
+          keys |= (uint64_t)1 << (r*NCOL + c);
+      gp_pin_set(cols+c,0);
+    }
+
+    return keys;
+  }
+
+//==============================================================================
+// debounce all keys at once (2-bit vertical counters)
+// - a counter runs while a key's sample differs from its debounced state and
+//   is cleared whenever they are equal; on overflow the state toggles
+// - returns the mask of toggled keys
+//==============================================================================
+
+  static uint64_t debounce(uint64_t keys)
+  {
+    uint64_t delta = keys ^ state;     // keys differing from debounced state
+
+    cnt1 = (cnt1 ^ cnt0) & delta;
+    cnt0 = ~cnt0 & delta;
+
+    uint64_t toggle = delta & ~(cnt0 | cnt1);  // counter wrapped to zero
+    state ^= toggle;
+    return toggle;
+  }
+
+//==============================================================================
+// idle mode: drive all columns, wait for any row interrupt
+//==============================================================================
+
+  static void idle(bool enable)
+  {
+    for (int c=0; c < NCOL; c++)
+      gp_pin_set(cols+c,enable);
+    for (int r=0; r < NROW; r++)
+      gp_int_cfg(rows+r, enable ? GPIO_INT_EDGE_TO_ACTIVE : GPIO_INT_DISABLE);
+  }
+
+//==============================================================================
+// scan worker
+//==============================================================================
+
+  static void scan_worker(struct k_work *work);
+  K_WORK_DELAYABLE_DEFINE(scan_work, scan_worker);
+
+  static void scan_worker(struct k_work *work)
+  {
+    uint64_t toggle = debounce(sample());
+
+    while (toggle)                     // post changed keys
+    {
+      int k = __builtin_ctzll(toggle);
+      toggle &= toggle - 1;
+
+      int val = (state >> k) & 1;
+      LOG(5,BL_Y "key @%d (row %d, col %d): %d", k+1, k/NCOL, k%NCOL, val);
+      _bl_msg((PMI),_BUTTON,STS_, k+1,NULL,val);  // (B)<-[#BUTTON:STS @k,val]
+    }
+
+    if (state || cnt0 || cnt1)
+      k_work_schedule(&scan_work, K_MSEC(CFG_KEY_SCAN_MS));
+    else
+      idle(true);                      // all keys released and stable
+  }
+
+//==============================================================================
+// row ISR (idle mode only): start scanning
+//==============================================================================
+
+  static void isr(GP_dev *dev, GP_ctx *ctx, GP_pins pins)
+  {
+    idle(false);
+    k_work_schedule(&scan_work, K_NO_WAIT);
+  }
+
+//==============================================================================
+// worker: init module
+//==============================================================================
+
+  static int sys_init(BL_ob *o, int val)
+  {
+    LOG(4,BL_B "init bl_hwkey (%dx%d keys) ...", NROW, NCOL);
+
+    for (int c=0; c < NCOL; c++)
+    {
+      if (!gp_ready(cols[c].port))
+        return -ENODEV;
+      gp_pin_cfg(cols+c, GPIO_OUTPUT_INACTIVE);
+    }
+
+    for (int r=0; r < NROW; r++)
+    {
+      if (!gp_ready(rows[r].port))
+        return -ENODEV;
+      gp_pin_cfg(rows+r, GPIO_INPUT);
+      gp_add_cb(rows+r, row_ctx+r, isr);
+    }
+
+    idle(true);                        // wait for first key press
+    return 0;
+  }
+
+#else // NKEY == 0
+
+  static int sys_init(BL_ob *o, int val)
+  {
+    return 0;                          // no keypad
+  }
+
+#endif // NKEY
+//==============================================================================
+// public module interface
+//==============================================================================
+//
+// (!) := (<parent>);  (#) := (bl_hwkey);  (B) := (bl_hwbut);
+//
+//                  +--------------------+
+//                  |      bl_hwkey      | module bl_hwkey
+//                  +--------------------+
+//                  |        SYS:        | SYS interface
+// (!)->     INIT ->|       <out>        | init module, store <out> callback
+//                  +--------------------+
+//                  |       BUTTON:      | BUTTON output interface
+// (B)<-      STS <-|       @k,sts       | debounced key @k state changed
+//                  |....................|
+//                  |      #BUTTON:      | BUTTON private interface
+// (#)->      STS ->|       @k,sts       | debounced key @k state changed
+//                  +--------------------+
+//
+//==============================================================================
+
+  int bl_hwkey(BL_ob *o, int val)      // key matrix module interface
+  {
+    static BL_oval B = bl_hwbut;       // output goes to bl_hwbut
+
+    switch (bl_id(o))
+    {
+      case BL_ID(_SYS,INIT_):
+        B = bl_cb(o,(B),WHO"(B)");     // store output callback
+        return sys_init(o,val);        // delegate to sys_init() worker
+
+      case _BL_ID(_BUTTON,STS_):
+        return bl_out(o,val,(B));      // post to output subscriber
+
+      default:
+        return -1;                     // bad input
+    }
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
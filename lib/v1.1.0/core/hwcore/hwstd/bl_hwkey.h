@@ -0,0 +1,59 @@
+//==============================================================================
+// bl_hwkey.h
+// Bluccino key matrix driver (scanned keypad)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+// the keypad is described by a devicetree node with alias `keypad` and the
+// properties `row-gpios` (inputs) and `col-gpios` (outputs, driven one at a
+// time during a scan), e.g.
+//
+//   / { aliases { keypad = &keypad; };
+//       keypad: keypad { compatible = "gpio-kbd-matrix";
+//                        row-gpios = <&gpio0 3 (GPIO_ACTIVE_LOW|GPIO_PULL_UP)>, ...;
+//                        col-gpios = <&gpio0 28 GPIO_ACTIVE_HIGH>, ...; }; };
+//
+// key @k (k = 1..NKEY) is located at row (k-1)/NCOL and column (k-1)%NCOL.
+// debounced key states are passed to bl_hwbut, which feeds them into the
+// PRESS/RELEASE/CLICK/HOLD state machine as buttons @NBUT+1 .. @NBUT+NKEY
+//==============================================================================
+
+#ifndef __BL_HWKEY_H__
+#define __BL_HWKEY_H__
+
+//==============================================================================
+// config defaults
+//==============================================================================
+
+#ifndef CFG_KEY_SCAN_MS
+  #define CFG_KEY_SCAN_MS       5      // key matrix scan period (ms)
+#endif
+
+//==============================================================================
+// keypad dimensions (from devicetree)
+//==============================================================================
+
+  #define KEYPAD    DT_ALIAS(keypad)   // DT node ID for key matrix
+
+  #if DT_NODE_HAS_STATUS(KEYPAD, okay)
+    #define NROW    DT_PROP_LEN(KEYPAD,row_gpios)
+    #define NCOL    DT_PROP_LEN(KEYPAD,col_gpios)
+  #else
+    #define NROW    0                  // no keypad
+    #define NCOL    0
+  #endif
+
+  #define NKEY      (NROW * NCOL)      // number of keys
+
+  #if (NKEY > 64)
+    #error NKEY                        // up to 64 keys supported
+  #endif
+
+//==============================================================================
+// public module interface
+//==============================================================================
+
+  int bl_hwkey(BL_ob *o, int val);     // key matrix module interface
+
+#endif // __BL_HWKEY_H__
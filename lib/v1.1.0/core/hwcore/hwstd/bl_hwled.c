@@ -24,6 +24,9 @@
 
 //==============================================================================
 // defines
+// - CFG_LED_PWM: use PWM channels (aliases pwm-led0..3) where available, LEDs
+//   without a PWM alias fall back to plain GPIO (on for any level > 0)
+// - CFG_LED_STEP_MS: interpolation step time of smooth ('~') LED animations
 //==============================================================================
 
   #ifdef ONE_LED_ONE_BUTTON_BOARD      // overrules everything !!!
@@ -35,6 +38,18 @@
     #define CFG_NUMBER_OF_LEDS     4
   #endif
 
+  #ifndef CFG_LED_PWM
+    #if defined(CONFIG_PWM)
+      #define CFG_LED_PWM          1   // PWM LEDs if PWM driver is enabled
+    #else
+      #define CFG_LED_PWM          0   // GPIO only
+    #endif
+  #endif
+
+  #ifndef CFG_LED_STEP_MS
+    #define CFG_LED_STEP_MS        10  // interpolation step (ms)
+  #endif
+
   #define NLEDS  CFG_NUMBER_OF_LEDS
 
     // define devicetree node IDs (NIDs) for LEDs
@@ -44,11 +59,15 @@
   #define NID_LED2          DT_ALIAS(led2)
   #define NID_LED3          DT_ALIAS(led3)
 
+  #if CFG_LED_PWM
+    #include <zephyr/drivers/pwm.h>
+  #endif
+
 //==============================================================================
 // locals
 // - LEDs are represented by their device tree specs (struct gpio_dt_spec)
 // - from device tree specs we store all references in the pointer array led[]
-// - additionally we want to know the on/off state of each LED
+// - additionally we want to know the brightness level (0..100) of each LED
 // - all this data structures are statically initialized, but keep in mind that
 //   during initializing we should check the ready state of each LED device
 //==============================================================================
@@ -64,34 +83,286 @@
 
   static const struct gpio_dt_spec *led[4] = {&led0,&led1,&led2,&led3};
 
-    // additionally we want to now the on/off state of each LED
+    // additionally we want to now the level (0..100) of each LED
+
+  static uint8_t led_lvl[4] = {0,0,0,0};
+
+//==============================================================================
+// PWM channels (optional, per LED)
+// - an LED with a pwm-led<n> alias is dimmed by PWM, otherwise driven by GPIO
+//==============================================================================
+
+#if CFG_LED_PWM
+
+  #if DT_NODE_EXISTS(DT_ALIAS(pwm_led0))
+    static const struct pwm_dt_spec pwm0 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led0));
+    #define PWM0  &pwm0
+  #else
+    #define PWM0  NULL
+  #endif
+
+  #if DT_NODE_EXISTS(DT_ALIAS(pwm_led1))
+    static const struct pwm_dt_spec pwm1 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led1));
+    #define PWM1  &pwm1
+  #else
+    #define PWM1  NULL
+  #endif
+
+  #if DT_NODE_EXISTS(DT_ALIAS(pwm_led2))
+    static const struct pwm_dt_spec pwm2 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led2));
+    #define PWM2  &pwm2
+  #else
+    #define PWM2  NULL
+  #endif
+
+  #if DT_NODE_EXISTS(DT_ALIAS(pwm_led3))
+    static const struct pwm_dt_spec pwm3 = PWM_DT_SPEC_GET(DT_ALIAS(pwm_led3));
+    #define PWM3  &pwm3
+  #else
+    #define PWM3  NULL
+  #endif
+
+  static const struct pwm_dt_spec *pwm[4] = {PWM0,PWM1,PWM2,PWM3};
+
+#endif // CFG_LED_PWM
+
+//==============================================================================
+// gamma table (gamma 2.2)
+// - maps perceived brightness level 0..100 to PWM duty cycle in 1/10000 units
+//==============================================================================
+
+  static const uint16_t gamma_lut[101] =
+  {
+        0,    0,    2,    4,    8,   14,   21,   29,   39,   50,
+       63,   78,   94,  112,  132,  154,  177,  203,  230,  259,
+      290,  323,  358,  394,  433,  474,  516,  561,  608,  657,
+      707,  760,  815,  872,  932,  993, 1056, 1122, 1190, 1260,
+     1332, 1406, 1483, 1562, 1643, 1726, 1812, 1899, 1989, 2082,
+     2176, 2273, 2373, 2474, 2578, 2684, 2793, 2904, 3017, 3132,
+     3250, 3371, 3494, 3619, 3746, 3876, 4009, 4143, 4281, 4420,
+     4563, 4707, 4854, 5004, 5156, 5310, 5468, 5627, 5789, 5954,
+     6121, 6290, 6462, 6637, 6814, 6994, 7176, 7361, 7549, 7739,
+     7931, 8126, 8324, 8524, 8727, 8933, 9141, 9352, 9565, 9781,
+    10000,
+  };
+
+//==============================================================================
+// animation state (one per LED)
+// - pattern syntax as in the 10-ui blink lesson: "intro:repeat", e.g.
+//   "rrr---:r-" plays "rrr---" once and then repeats "r-" forever
+// - each pattern character is a keyframe lasting ms milliseconds:
+//   '-' or ' ': off, '0'..'9': level 0..100%, any other character: on
+// - for @ix=0 the pattern drives the LED group like the blink lesson does:
+//   's': status LED @1, 'r','g','b': LED @2,@3,@4, 'w': LEDs @2..@4
+// - a leading '~' interpolates linearly between keyframes (e.g. "~09" breathes)
+// - an empty pattern (or empty repeat part) turns the LED(s) off
+// - keyframe deadlines are exact multiples of ms after the animation start
+//   (not rounded to CFG_LED_STEP_MS, which is the interpolation rate only)
+// - pattern strings are referenced, not copied (must be static)
+//==============================================================================
+
+  typedef struct LED_anim
+  {
+    BL_txt text;                       // (repeat) pattern text
+    BL_txt p;                          // next pattern character
+    int ms;                            // ms per keyframe (0: inactive)
+    int64_t start;                     // start time of current keyframe (ms)
+    uint8_t from;                      // level at start of current keyframe
+    uint8_t to;                        // level of current keyframe
+    bool smooth;                       // interpolate between keyframes
+    bool group;                        // pattern addresses LED group (@ix=0)
+    uint8_t gen;                       // bumped on animation (re)start/stop
+  } LED_anim;
+
+//==============================================================================
+// animation locking
+// - the animation state is guarded by a spinlock, since [LED:SET] and
+//   [LED:TOGGLE] may come from ISR context (e.g. BL_timer callbacks)
+// - LED drivers are never called with the lock held: levels are computed
+//   under the lock and applied afterwards, skipping a level if the LED's
+//   animation has been restarted or stopped meanwhile (gen changed)
+//==============================================================================
+
+  static LED_anim anim[4];
+  static struct k_work_delayable sequencer;  // animation sequencer work
+  static struct k_spinlock led_lock;   // protects animation state
+
+//==============================================================================
+// helper: set LED level (i: 0..3, level: 0..100)
+// - never called with led_lock held
+//==============================================================================
+
+  static int led_level(int i, int level)
+  {
+    if (led_lvl[i] == level)
+      return 0;                        // nothing to do
+
+    led_lvl[i] = (uint8_t)level;
+
+    #if CFG_LED_PWM
+      if (pwm[i])
+      {
+        uint32_t pulse = (uint32_t)((uint64_t)pwm[i]->period*gamma_lut[level]/10000);
+        return pwm_set_pulse_dt(pwm[i],pulse);
+      }
+    #endif
+
+	  return gpio_pin_set_dt(led[i],level > 0);
+  }
+
+//==============================================================================
+// helper: map pattern character to level of LED @ix (1..4)
+//==============================================================================
+
+  static int keylevel(char c, int ix, bool group)
+  {
+    if (c >= '0' && c <= '9')
+      return (c - '0') * 100 / 9;      // '0' -> 0%, '9' -> 100%
+
+    if (c == '-' || c == ' ')
+      return 0;
+
+    if (!group)
+      return 100;                      // any other character: on
+
+    switch (c)
+    {
+      case 's': return ix == 1 ? 100 : 0;  // status LED on
+      case 'r': return ix == 2 ? 100 : 0;  // red LED on
+      case 'g': return ix == 3 ? 100 : 0;  // green LED on
+      case 'b': return ix == 4 ? 100 : 0;  // blue LED on
+      case 'w': return ix >= 2 ? 100 : 0;  // white (RGB) LED on
+      default:  return 0;
+    }
+  }
+
+//==============================================================================
+// helper: load next keyframe of LED i (i: 0..3), called with led_lock held
+// - return LED level to be applied (-1: none)
+//==============================================================================
+
+  static int keyframe(LED_anim *a, int i)
+  {
+    if (*a->p == ':')                  // pattern separator
+      a->p = a->text = a->p + 1;       // switch to repeat part
+
+    if (!*a->p)
+    {
+      a->p = a->text;                  // reload repeat pattern
+      if (!*a->p)
+      {
+        a->ms = 0;                     // no effective pattern => stop
+        return 0;                      // and LED off (as 10-ui blinker)
+      }
+    }
+
+    a->from = led_lvl[i];
+    a->to = keylevel(*a->p++, i+1, a->group);
 
-  static bool led_onoff[4] = {0,0,0,0};
+    return a->smooth ? -1 : a->to;     // step animation: jump to keyframe
+  }
+
+//==============================================================================
+// helper: apply computed LED levels (outside of led_lock)
+//==============================================================================
+
+  static void apply(int *lvl, uint8_t *gen)
+  {
+    for (int i = 0; i < NLEDS; i++)
+      if (lvl[i] >= 0 && anim[i].gen == gen[i])
+        led_level(i,lvl[i]);
+  }
+
+//==============================================================================
+// sequencer step (delayable work, system work queue)
+// - animations progress without any message traffic or main loop activity
+// - the work reschedules itself for the earliest keyframe deadline (or next
+//   interpolation step) and stays idle as soon as no animation is active
+//==============================================================================
+
+  static void sequencer_step(struct k_work *work)
+  {
+    int64_t now = k_uptime_get();
+    int64_t next = INT64_MAX;
+    int lvl[4] = {-1,-1,-1,-1};        // levels to apply
+    uint8_t gen[4];
+
+    k_spinlock_key_t key = k_spin_lock(&led_lock);
+
+    for (int i = 0; i < NLEDS; i++)
+    {
+      LED_anim *a = anim + i;
+      gen[i] = a->gen;
+
+      while (a->ms && now >= a->start + a->ms)
+      {
+        a->start += a->ms;             // exact deadline, no drift
+        int l = keyframe(a,i);         // next keyframe
+        if (l >= 0)
+          lvl[i] = l;
+      }
+
+      if (!a->ms)
+        continue;                      // inactive or finished
+
+      int64_t due = a->start + a->ms;  // next keyframe deadline
+
+      if (a->smooth)
+      {
+        int t = (int)(now - a->start);
+        lvl[i] = a->from + (a->to - a->from) * t / a->ms;
+        due = MIN(due, now + CFG_LED_STEP_MS);
+      }
+
+      next = MIN(next, due);
+    }
+
+    k_spin_unlock(&led_lock,key);
+
+    apply(lvl,gen);                    // drive LEDs outside of the lock
+
+    if (next != INT64_MAX)
+      k_work_reschedule(&sequencer, K_MSEC(next - now));
+  }
+
+//==============================================================================
+// helper: stop animation of LED i (i: 0..3)
+//==============================================================================
+
+  static void anim_stop(int i)
+  {
+    k_spinlock_key_t key = k_spin_lock(&led_lock);
+    anim[i].ms = 0;
+    anim[i].gen++;                     // discard levels computed meanwhile
+    k_spin_unlock(&led_lock,key);
+  }
 
 //==============================================================================
 // LED set  [SET:LED @ix onoff]  // @ix = 1..4
 //==============================================================================
 
-  static int led_set(BL_ob *o, int onoff)
+  static int led_set(BL_ob *o, int level)
   {
     int ix = bl_ix(o);                 // LED index, range 1..4
     if (ix == 0 || ix > NLEDS)
       return -1;                       // bad input
 
+    level = level < 0 ? 0 : (level > 100 ? 100 : level);
+
     if (1 <= ix && ix <= 4)
     {
        int i = ix - 1;                 // map range 1..4 to range 0..3
-       led_onoff[i] = onoff;
-		   return gpio_pin_set_dt(led[i],onoff);
+       anim_stop(i);
+		   return led_level(i,level);
     }
-    else if (ix < 0)                   // set all 4 LEDs to given status
+    else if (ix < 0)                   // set all 4 LEDs to given level
     {
        int err = 0;
 
        for (int i = 0; i < NLEDS; i++)
        {
-         led_onoff[i] = onoff;
-         err = err || gpio_pin_set_dt(led[i],onoff);
+         anim_stop(i);
+         err = err || led_level(i,level);
        }
        return err;
     }
@@ -109,16 +380,67 @@
       return -1;                       // bad args
 
     if (ix > 0)
-      val = (led_onoff[ix-1] == 0);    // new LED value
+      val = (led_lvl[ix-1] == 0);      // new LED value
     else
-      val = !(led_onoff[0] || led_onoff[1] || led_onoff[2] || led_onoff[3]);
+      val = !(led_lvl[0] || led_lvl[1] || led_lvl[2] || led_lvl[3]);
 
-    int err = led_set(o,val);          // toggle LED state
+    int err = led_set(o,val ? 100 : 0);// toggle LED state
 
     LOGO(4,BL_Y,o,val);                // log changed LED level
     return err;
   }
 
+//==============================================================================
+// LED blink  [LED:BLINK @ix,"pattern",ms]  // @ix = 0..4, or < 0 (all)
+// - ms = 0: no animation, but apply first pattern character once
+//==============================================================================
+
+  static int led_blink(BL_ob *o, int ms)
+  {
+    int ix = bl_ix(o);                 // LED index, range 0..4
+    BL_txt pattern = bl_data(o);
+
+    if (ix > NLEDS)
+      return -1;                       // bad input
+    if (!pattern)
+      return bl_err(-EINVAL,"invalid pattern (NULL)");
+
+    bool smooth = (*pattern == '~');
+    pattern += smooth;
+
+    int64_t now = k_uptime_get();
+    int lvl[4] = {-1,-1,-1,-1};        // levels to apply
+    uint8_t gen[4] = {0,0,0,0};
+
+    k_spinlock_key_t key = k_spin_lock(&led_lock);
+
+    for (int i = 0; i < NLEDS; i++)
+    {
+      if (ix > 0 && i != ix-1)
+        continue;                      // not addressed
+
+      LED_anim *a = anim + i;
+      a->text = a->p = pattern;
+      a->smooth = smooth && ms > 0;
+      a->group = (ix == 0);
+      a->start = now;
+      a->gen++;                        // discard levels computed meanwhile
+      gen[i] = a->gen;
+      a->ms = ms > 0 ? ms : 1;         // non-zero while loading 1st keyframe
+      lvl[i] = keyframe(a,i);          // load 1st keyframe
+
+      if (ms <= 0)
+        a->ms = 0;                     // one-shot: stop after 1st keyframe
+    }
+
+    k_spin_unlock(&led_lock,key);
+    apply(lvl,gen);
+
+    if (ms > 0)
+      k_work_reschedule(&sequencer, K_NO_WAIT);  // sequencer takes over
+    return 0;
+  }
+
 //==============================================================================
 // helper: LED init (index range: 1..4)
 //==============================================================================
@@ -127,6 +449,15 @@
   {
     int i = ix - 1;                    // map range 1..4 to range 0..3
 
+    #if CFG_LED_PWM
+      if (pwm[i])
+      {
+        if (!device_is_ready(pwm[i]->dev))
+          return bl_err(1,bl_fmt("PWM LED @%d not ready",ix));
+        return pwm_set_pulse_dt(pwm[i],0);
+      }
+    #endif
+
     if (!device_is_ready(led[i]->port))
       return bl_err(1,bl_fmt("LED @%d not ready",ix));
 
@@ -146,6 +477,8 @@
 
     LOG(4,BL_B "init %d LED%s",NLEDS, NLEDS==1?"":"s");
 
+    k_work_init_delayable(&sequencer,sequencer_step);
+
     for (int ix = 1; ix <= NLEDS; ix++)
        err = err || led_init(ix);
 
@@ -154,9 +487,10 @@
 
 //==============================================================================
 // public module interface
-// - @ix = 0: status LED (same as @ix=1)
-// - @ix = 1..4: LED @ix (same as @ix=1)
+// - @ix = 0: status LED (same as @ix=1), for BLINK: LED group (see above)
+// - @ix = 1..4: LED @ix
 // - @ix < 0: set all 4 LEDs status to given value
+// - SET, TOGGLE and LEVEL stop a running animation of the addressed LED(s)
 //==============================================================================
 //
 // (!) := (<parent>);
@@ -169,6 +503,8 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @ix,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @ix         | toggle LED's onoff state
+// (!)->    LEVEL ->|     @ix,level      | set LED's brightness (0..100)
+// (!)->    BLINK ->|  @ix,"pattern",ms  | run LED animation (ms per keyframe)
 //                  +--------------------+
 //
 //==============================================================================
@@ -187,7 +523,7 @@
           LOGO(4,"@",o,val);
 
         o = bl_ix(o) ? o : &oo;        // if (bl_ix(o)==0) re-map o to &oo
-	      return led_set(o,val != 0);    // delegate to led_set();
+	      return led_set(o,val ? 100 : 0); // delegate to led_set();
       }
 
       case BL_ID(_LED,TOGGLE_):
@@ -197,6 +533,18 @@
 	      return led_toggle(o,val);      // delegate to led_toggle();
       }
 
+      case BL_ID(_LED,LEVEL_):
+      {
+        BL_ob oo = {o->cl,o->op,1,NULL};  // change @ix=0 -> @ix=1
+        LOGO(4,"@",o,val);
+        o = bl_ix(o) ? o : &oo;        // if (bl_ix(o)==0) re-map o to &oo
+	      return led_set(o,val);         // delegate to led_set();
+      }
+
+      case BL_ID(_LED,BLINK_):
+        LOGO(4,"@",o,val);
+	      return led_blink(o,val);       // delegate to led_blink();
+
       default:
 	      return -1;                     // bad input
     }
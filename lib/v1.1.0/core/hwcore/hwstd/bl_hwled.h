@@ -8,6 +8,9 @@
 // LED interface:
 // - LED messages [LED:SET @ix onoff] control the onoff state of one of the four
 // - LEDs @1..@4. LED @0 is the status LED which will be remapped to LED @1
+// - [LED:LEVEL @ix,level] dims LED @ix (0..100, gamma corrected, PWM LEDs)
+// - [LED:BLINK @ix,"pattern",ms] runs an LED animation in the driver, stepped
+//   by a timer (no SYS:TICK or message traffic per step)
 //==============================================================================
 
 #ifndef __BL_HWLED_H__
@@ -27,6 +30,8 @@
 //                  |        LED:        | LED interface
 // (!)->      SET ->|      @ix,onoff     | set LED's onoff state
 // (!)->   TOGGLE ->|        @ix         | toggle LED's onoff state
+// (!)->    LEVEL ->|     @ix,level      | set LED's brightness (0..100)
+// (!)->    BLINK ->|  @ix,"pattern",ms  | run LED animation (ms per keyframe)
 //                  +--------------------+
 //
 //==============================================================================
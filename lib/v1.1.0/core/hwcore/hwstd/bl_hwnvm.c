@@ -27,6 +27,41 @@
   #define LOGO(lvl,col,o,val)     LOGO_NVM(lvl,col WHO,o,val)
   #define LOG0(lvl,col,o,val)     LOGO_NVM(lvl,col,o,val)
 
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_NVM_CACHE_KEYS
+    #define CFG_NVM_CACHE_KEYS  8      // max number of cached NVM keys
+  #endif
+  #ifndef CFG_NVM_CACHE_BYTES
+    #define CFG_NVM_CACHE_BYTES 32     // max data size of a cached NVM item
+  #endif
+  #ifndef CFG_NVM_KEY_LEN
+    #define CFG_NVM_KEY_LEN     24     // max key length (incl. terminator)
+  #endif
+
+//==============================================================================
+// typedef: NVM cache entry
+// - entries are allocated on first [NVM:LOAD] or [NVM:SAVE] of a key, loaded
+//   lazily from flash on first access, and written back (only if dirty) in
+//   one batch on [SYS:TOCK] or [NVM:FLUSH]
+//==============================================================================
+
+  #define NVC_LOADED  0x01             // flash has been consulted for key
+  #define NVC_VALID   0x02             // entry holds a value
+  #define NVC_DIRTY   0x04             // value needs to be written to flash
+
+  typedef struct BL_nvc                // NVM cache entry
+          {
+            char key[CFG_NVM_KEY_LEN]; // settings key (empty: free entry)
+            uint8_t size;              // data size (entry type)
+            uint8_t flags;             // NVC_LOADED | NVC_VALID | NVC_DIRTY
+            uint8_t data[CFG_NVM_CACHE_BYTES];
+          } BL_nvc;
+
+  static BL_nvc cache[CFG_NVM_CACHE_KEYS];
+
 //==============================================================================
 // typedef: internal type for fetching data
 //==============================================================================
@@ -137,28 +172,129 @@
     return err;
   }
 
+//==============================================================================
+// helper: lookup cache entry for key, allocate a free one if not found
+// - returns NULL if key or data size don't fit or the cache is full
+//==============================================================================
+
+  static BL_nvc *lookup(BL_txt key, size_t size)
+  {
+    BL_nvc *slot = NULL;
+
+    if (strlen(key) >= CFG_NVM_KEY_LEN || size > CFG_NVM_CACHE_BYTES)
+      return NULL;                     // not cacheable
+
+    for (int i=0; i < BL_LEN(cache); i++)
+    {
+      if (cache[i].key[0] == 0)
+        slot = slot ? slot : cache + i;
+      else if (strcmp(cache[i].key,key) == 0)
+        return cache + i;              // found
+    }
+
+    if (slot)
+    {
+      strcpy(slot->key,key);
+      slot->size = (uint8_t)size;
+      slot->flags = 0;
+    }
+    return slot;
+  }
+
+//==============================================================================
+// helper: flush all dirty cache entries to flash
+//==============================================================================
+
+  static int flush(void)
+  {
+    int err = 0;
+
+    for (int i=0; i < BL_LEN(cache); i++)
+    {
+      BL_nvc *p = cache + i;
+      if (p->flags & NVC_DIRTY)
+      {
+        int rv = save(p->key, p->data, p->size);
+        if (rv == 0)
+          p->flags &= ~NVC_DIRTY;
+        else
+          err = rv;                    // keep dirty, retry with next flush
+      }
+    }
+    return err;
+  }
+
 //==============================================================================
 // worker: load from NVM using BL_nvm structure
 // - usage: FD_nvm nvm = {key, &value, sizeof(value)};
 //          err = bl_msg((fd_nvm), _NVM,LOAD_, 0,&nvm,0);
+// - only the first load of a key accesses flash, subsequent loads (and
+//   loads after saves) are served from the NVM cache
 //==============================================================================
 
   static int nvm_load(BL_ob *o, int val)
   {
     BL_tray *p = bl_data(o);
-    return load(p->key, p->data, p->size);
+    BL_nvc *c = lookup(p->key, p->size);
+
+    if (c == NULL)                     // not cacheable
+      return load(p->key, p->data, p->size);
+
+    if (c->size != p->size)
+      return bl_err(-EINVAL,"nvm_load(): type mismatch");
+
+    if (!(c->flags & NVC_LOADED))
+    {
+      int err = load(c->key, c->data, c->size);
+      if (err && err != -ENOENT)
+        return err;
+
+      c->flags |= NVC_LOADED | (err ? 0 : NVC_VALID);
+    }
+
+    if (!(c->flags & NVC_VALID))
+      return -ENOENT;                  // no such item in NVM
+
+    memcpy(p->data, c->data, c->size);
+    return 0;
   }
 
 //==============================================================================
 // worker: save to NVM using BL_nvm structure
 // - usage: FD_nvm nvm = {key, &value, sizeof(value)};
 //          err = bl_msg((fd_nvm), _NVM,SAVE_, 0,&nvm,0);
+// - data is written to the NVM cache, the key is marked dirty only if the
+//   value has changed; dirty keys are written with the next flush
+// - like nvm_load() a save with a size other than the key's cached size is
+//   rejected with -EINVAL (type mismatch)
 //==============================================================================
 
   static int nvm_save(BL_ob *o, int val)
   {
     BL_tray *p = bl_data(o);
-    return save(p->key, p->data, p->size);
+    BL_nvc *c = lookup(p->key, p->size);
+
+    if (c == NULL)                     // not cacheable
+      return save(p->key, p->data, p->size);
+
+    if (c->size != p->size)
+      return bl_err(-EINVAL,"nvm_save(): type mismatch");
+
+    if ((c->flags & NVC_VALID) && memcmp(c->data, p->data, p->size) == 0)
+      return 0;                        // unchanged, nothing to write
+
+    memcpy(c->data, p->data, p->size);
+    c->flags |= NVC_LOADED | NVC_VALID | NVC_DIRTY;
+    return 0;
+  }
+
+//==============================================================================
+// worker: flush dirty NVM cache entries (on tock and before power down)
+//==============================================================================
+
+  static int nvm_flush(BL_ob *o, int val)
+  {
+    return flush();
   }
 
 //==============================================================================
@@ -191,10 +327,12 @@
 //                  +--------------------+
 //                  |        SYS:        | SYS input interface
 // (H)->     INIT ->|        <cb>        | init module, store <out> callback
+// (H)->     TOCK ->|       @ix,cnt      | flush dirty NVM cache entries
 //                  +--------------------+
 //                  |        NVM:        | NVM input interface
-// (H)->     LOAD ->|      <BL_tray>      | load NVM data
-// (H)->     SAVE ->|      <BL_tray>      | save NVM data
+// (H)->     LOAD ->|      <BL_tray>      | load NVM data (cached)
+// (H)->     SAVE ->|      <BL_tray>      | save NVM data (write-behind)
+// (H)->    FLUSH ->|                    | flush NVM cache (e.g. power down)
 // (H)->  SUPPORT ->|                    | is NVM functionality supported?
 //                  |....................|
 //                  |        NVM:        | NVM output interface
@@ -213,6 +351,10 @@
          U = bl_cb(o,(U),WHO"(U)");    // store output callback
          return sys_init(o,val);       // delegate to sys_init() worker
 
+       case SYS_TOCK_ix_BL_pace_cnt:    // [SYS:TOCK @ix,cnt]
+       case NVM_FLUSH_0_0_0:            // [NVM:FLUSH]
+         return nvm_flush(o,val);      // delegate to nvm_flush() worker
+
        case NVM_LOAD_0_BL_tray_0:       // [NVM:LOAD <BL_tray>]
          return nvm_load(o,val);       // delegate to nvm_load() worker
 
@@ -0,0 +1,100 @@
+//==============================================================================
+// bl_boot.c
+// boot phase profiling of the wireless core (startup report)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+
+  #include "bluccino.h"
+  #include "bl_boot.h"
+
+//==============================================================================
+// logging shorthands
+//==============================================================================
+
+  #define WHO                     "boot:"
+
+  #define LOG                     LOG_CORE
+  #define LOGO(lvl,col,o,val)     LOGO_CORE(lvl,col WHO,o,val)
+  #define LOG0(lvl,col,o,val)     LOGO_CORE(lvl,col,o,val)
+
+//==============================================================================
+// locals
+//==============================================================================
+
+  static const char *boot_txt[BOOT_PHASES] =
+  {
+    "wl init", "bt enable", "wl done", "bt ready",
+    "mesh init", "settings", "nvm ready", "prov enable",
+  };
+
+  static int64_t boot_stamp[BOOT_PHASES];
+  static atomic_t boot_mask;           // bit mask of stamped phases
+  static atomic_t boot_skip;           // bit mask of skipped phases
+
+//==============================================================================
+// log startup report
+//==============================================================================
+
+  static void boot_report(void)
+  {
+    int64_t prev = 0;
+
+    LOG(2,BL_C "startup report (%d phases)", BOOT_PHASES);
+    for (int i=0; i < BOOT_PHASES; i++)
+    {
+      LOG(2,BL_C WHO "%6d ms (%+d) %s%s", (int)boot_stamp[i],
+          (int)(boot_stamp[i]-prev), boot_txt[i],
+          (atomic_get(&boot_skip) & (1 << i)) ? " (skipped)" : "");
+      prev = boot_stamp[i];
+    }
+  }
+
+//==============================================================================
+// helper: stamp a boot phase (reached or skipped)
+//==============================================================================
+
+  static void stamp(BL_boot phase, bool skipped)
+  {
+    if (phase < 0 || phase >= BOOT_PHASES)
+      return;
+
+    atomic_val_t bit = (atomic_val_t)1 << phase;
+    atomic_val_t all = ((atomic_val_t)1 << BOOT_PHASES) - 1;
+
+    if (atomic_get(&boot_mask) & bit)
+      return;                          // already stamped
+
+    boot_stamp[phase] = k_uptime_get();
+    if (skipped)
+      atomic_or(&boot_skip,bit);
+
+    atomic_val_t old = atomic_or(&boot_mask,bit);
+    if (!(old & bit) && (old | bit) == all)
+      boot_report();                   // last phase stamped => report
+  }
+
+//==============================================================================
+// stamp a boot phase
+//==============================================================================
+
+  void bl_boot(BL_boot phase)
+  {
+    stamp(phase,false);
+  }
+
+//==============================================================================
+// mark a boot phase as skipped
+//==============================================================================
+
+  void bl_boot_skip(BL_boot phase)
+  {
+    stamp(phase,true);
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
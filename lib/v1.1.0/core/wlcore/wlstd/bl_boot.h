@@ -0,0 +1,55 @@
+//==============================================================================
+// bl_boot.h
+// boot phase profiling of the wireless core (startup report)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+// each phase is stamped with k_uptime_get() the first time it is reached.
+// once all phases have been stamped a single startup report is logged:
+//
+//   boot:   112 ms (+112) wl init
+//   boot:   115 ms   (+3) bt enable
+//   ...
+//
+// phases may be stamped from different threads (BT enable runs async)
+//==============================================================================
+
+#ifndef __BL_BOOT_H__
+#define __BL_BOOT_H__
+
+  #include <stdint.h>
+
+//==============================================================================
+// boot phases (in nominal order)
+//==============================================================================
+
+  typedef enum BL_boot
+          {
+            BOOT_WL_INIT,              // wireless core init started
+            BOOT_BT_ENABLE,            // bt_enable() requested (async)
+            BOOT_WL_DONE,              // wireless core init returned
+            BOOT_BT_READY,             // Bluetooth ready callback
+            BOOT_MESH_INIT,            // bt_mesh_init() done
+            BOOT_SETTINGS,             // settings_load() done
+            BOOT_NVM_READY,            // NVM cache committed
+            BOOT_PROV_ENABLE,          // provisioning bearers enabled
+            BOOT_PHASES,               // number of boot phases
+          } BL_boot;
+
+//==============================================================================
+// stamp a boot phase
+// - usage: bl_boot(BOOT_SETTINGS)    // stamp phase (first occurrence only)
+// - the startup report is logged as soon as the last phase has been stamped
+//==============================================================================
+
+  void bl_boot(BL_boot phase);
+
+//==============================================================================
+// mark a boot phase as skipped (e.g. after a failed init step)
+// - usage: bl_boot_skip(BOOT_MESH_INIT)  // counts as reached for the report
+//==============================================================================
+
+  void bl_boot_skip(BL_boot phase);
+
+#endif // __BL_BOOT_H__
@@ -71,25 +71,33 @@
 // BL_goo data structures, for any generic on/off server
 //==============================================================================
 
-  static BL_goo goo[1];              // only 1 generic on/off server
+  static BL_goo goo[VND_BULK_ELEMENTS];  // @ix 1: generic on/off server,
+                                         // @ix 2..: vendor bulk updates
 
 //==============================================================================
-// workhorse which post messages through the upward gear to the application
+// RX event queue (bounded ring of posts with inline payload)
+// - mesh handlers enqueue posts, the workhorse drains them in one batch
+// - a full queue drops the new post and counts the drop (never silently)
 //==============================================================================
 #if MIGRATION_STEP6                  // data structures for notification
 
+  #ifndef CFG_DCOMP_RXQ
+    #define CFG_DCOMP_RXQ  32        // RX event queue depth (power of 2)
+  #endif
+
   typedef struct TP_post
           {
             BL_ob oo;                // message object
             int val;                 // value to be posted
-
-            union pay
-            {
-              BL_gooset gooset;
-            } pay;
+            BL_goo goo;              // inline copy of generic on/off data
           } TP_post;
 
-  static TP_post post;
+  static TP_post rxq[CFG_DCOMP_RXQ];
+  static struct k_spinlock rxq_lock;
+  static uint32_t rxq_head = 0;      // next post to be drained
+  static uint32_t rxq_tail = 0;      // next free queue slot
+  static uint32_t rxq_drops = 0;     // number of dropped posts
+  static uint32_t rxq_depth = 0;     // max queue depth ever seen
 
 #endif
 //==============================================================================
@@ -99,19 +107,59 @@
 
   static void workhorse(struct k_work *work)
   {
-    bl_dcomp(&post.oo,post.val);       // post to module interface for output
+    TP_post post;
+    int n = 0;                         // number of posts in this batch
+
+    for (;;)
+    {
+      k_spinlock_key_t key = k_spin_lock(&rxq_lock);
+      bool empty = (rxq_head == rxq_tail);
+
+      if (!empty)
+        post = rxq[rxq_head++ % CFG_DCOMP_RXQ];
+      k_spin_unlock(&rxq_lock, key);
+
+      if (empty)
+        break;
+
+      post.oo.data = &post.goo;        // refer to inline payload
+      bl_dcomp(&post.oo,post.val);     // post to module interface for output
+      n++;
+    }
+
+    if (n > 1 || rxq_drops)
+      LOG(4,BL_Y "rxq: batch of %d posts (max depth: %d, drops: %d)",
+          n, (int)rxq_depth, (int)rxq_drops);
   }
 
   static K_WORK_DEFINE(work,workhorse);// assign work with workhorse
 
   static void submit(BL_ob *o, int val)
   {
-    memcpy(&post.oo,o,sizeof(BL_ob));
-    post.val = val;                    // copy val to note
-    k_work_submit(&work);              // invoke workhorse() to post note
+    k_spinlock_key_t key = k_spin_lock(&rxq_lock);
+    uint32_t n = rxq_tail - rxq_head;  // current queue depth
+
+    if (n >= CFG_DCOMP_RXQ)
+    {
+      rxq_drops++;
+      k_spin_unlock(&rxq_lock, key);
+      LOGO(1,BL_R "rxq full, drop:",o,val);
+      k_work_submit(&work);            // make sure queue gets drained
+      return;
+    }
+
+    TP_post *p = rxq + (rxq_tail++ % CFG_DCOMP_RXQ);
+    memcpy(&p->oo,o,sizeof(BL_ob));
+    p->val = val;                      // copy val to note
+    p->goo = *(BL_goo*)o->data;        // inline copy of payload
+    rxq_depth = BL_MAX(rxq_depth,n+1);
+    k_spin_unlock(&rxq_lock, key);
+
+    k_work_submit(&work);              // invoke workhorse() to drain queue
   }
 
-  static void goo_submit(BL_ob *o, BL_gooset *pay, bool acked, BL_txt msg)
+  static void goo_submit(BL_ob *o, BL_gooset *pay, BL_ms at, bool acked,
+                         BL_txt msg)
   {
     BL_ms now = bl_ms();
     int val = pay->target;
@@ -127,12 +175,21 @@
 
         // fill BL_goo structure
 
+      // begin at given network time <at> if we are synced, otherwise after
+      // the message delay (aligned to the network time grid, if enabled)
+
+    BL_ms begin = now + bl_tick2ms(pay->delay);
+    if (at && bl_net_synced())
+      begin = BL_MAX(now,bl_net2ms(at));
+    else
+      begin = bl_net_align(begin);
+
     BL_goo *g = goo + idx;
     g->trans.basis = bl_cur(&g->trans);
-    g->delay = bl_tick2ms(pay->delay);
+    g->delay = (int)(begin - now);
     g->trans.tt = bl_mesh2ms(pay->tt);
     g->trans.target = pay->target;
-    g->trans.begin = now + g->delay;
+    g->trans.begin = begin;
     g->remain = g->delay;
     g->tid = pay->tid;
     g->acked = acked;
@@ -142,8 +199,9 @@
     if (g->delay == 0 && g->trans.tt == 0)
       LOG0(5,msg,o,g->trans.target);
     else
-      LOG(5,BL_C"%s [#GONOFF:STS @%d,<#%d,&%d,/%d>,%d]", msg, bl_ix(o),
-        g->tid,(int)(g->trans.begin-now),(int)g->trans.tt, val);
+      LOG(5,BL_C"%s [#GONOFF:STS @%d,<#%d,&%d,/%d>,%d] (net begin %d)",
+        msg, bl_ix(o), g->tid,(int)(g->trans.begin-now),(int)g->trans.tt,
+        val, (int)(g->trans.begin + bl_net_ms() - now));
 
       // submit message
 
@@ -223,6 +281,84 @@ struct vendor_state vnd_user_data;
 
 static struct bt_mesh_elem elements[];
 
+/*
+ * Status cache for GET handlers
+ *
+ * Every GET handler keeps the last status PDU it built, together with the
+ * status epoch it was built for. The epoch is bumped by status_invalidate()
+ * on any state or transition change, so a GET storm from many clients is
+ * answered from the cached PDU as long as nothing has changed. PDUs built
+ * while a transition is running carry a remaining time and are not cached.
+ * The mesh stack encrypts a sent PDU in place and appends the MIC, so the
+ * cache keeps the plain bytes and every hit sends a fresh copy.
+ */
+
+#define STATUS_PDU_MAX	(2 + 9)		/* opcode + largest status payload */
+
+struct status_cache {
+	bool valid;
+	atomic_val_t epoch;		/* status epoch the PDU was built for */
+	uint8_t len;			/* length of precomputed status PDU */
+	uint8_t data[STATUS_PDU_MAX];	/* precomputed status PDU */
+};
+
+static atomic_t status_epoch;
+static uint32_t status_hits, status_misses;
+
+static struct status_cache onoff_status;
+static struct status_cache level_status;
+static struct status_cache lightness_status;
+static struct status_cache linear_status;
+static struct status_cache ctl_status;
+static struct status_cache level_temp_status;
+static struct status_cache ctl_temp_status;
+
+void status_invalidate(void)
+{
+	atomic_inc(&status_epoch);
+}
+
+static bool status_cached(struct status_cache *cache,
+			  struct bt_mesh_model *model,
+			  struct bt_mesh_msg_ctx *ctx)
+{
+	if (!cache->valid || cache->epoch != atomic_get(&status_epoch)) {
+		status_misses++;
+		return false;
+	}
+
+	NET_BUF_SIMPLE_DEFINE(msg, STATUS_PDU_MAX + BT_MESH_MIC_SHORT);
+	net_buf_simple_add_mem(&msg, cache->data, cache->len);
+
+	status_hits++;
+	if (bt_mesh_model_send(model, ctx, &msg, NULL, NULL)) {
+		LOG(5,"Unable to send cached status response");
+	}
+
+	return true;
+}
+
+static void status_store(struct status_cache *cache, atomic_val_t epoch,
+			 struct net_buf_simple *msg)
+{
+	if (ctl->transition->counter || msg->len > STATUS_PDU_MAX) {
+		cache->valid = false;	/* remaining time changes over time */
+		return;
+	}
+
+	memcpy(cache->data, msg->data, msg->len);
+	cache->len = msg->len;
+	cache->epoch = epoch;
+	cache->valid = true;
+}
+
+void status_cache_stats(uint32_t *hits, uint32_t *misses)
+{
+	*hits = status_hits;
+	*misses = status_misses;
+}
+
+
 /* message handlers (Start) */
 
 //==============================================================================
@@ -234,6 +370,11 @@ static int gen_onoff_get(struct bt_mesh_model *model,
 			 struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 3 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&onoff_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg, BT_MESH_MODEL_OP_GEN_ONOFF_STATUS);
 	net_buf_simple_add_u8(msg, (uint8_t) get_current(ONOFF));
@@ -249,6 +390,8 @@ static int gen_onoff_get(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&onoff_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send GEN_ONOFF_SRV Status response");
 	}
@@ -296,7 +439,8 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
     uint32_t oc = BL_GOOSET;
     static long bl_log_gonoff_set_rx = 0;
     long cnt = ++bl_log_gonoff_set_rx;
-    BL_gooset *pay = &post.pay.gooset;
+    BL_gooset gooset = {0};
+    BL_gooset *pay = &gooset;
   #endif
 
 	uint8_t tid, onoff, tt, delay;
@@ -314,10 +458,7 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC)))
+	if (bl_dejavu(model, ctx, tid, now))
   {
  		//(void)gen_onoff_get(model, ctx, buf);
 		LOG(5,BL_Y "ignore #%d repeat tid",tid);
@@ -354,12 +495,9 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
   #endif
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -393,7 +531,7 @@ static int gen_onoff_set_unack(struct bt_mesh_model *model,
     bool dummy = 0;
 SUBMIT:  dummy = 1;                    // need this in order to use label
     BL_ob oo = {BL_AUG(_GOOSRV),STS_,1,NULL};
-    goo_submit(&oo, pay, false, "goosrv:let:");
+    goo_submit(&oo, pay, 0, false, "goosrv:let:");
   #endif
   return 0;
 }
@@ -410,7 +548,8 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
       uint32_t oc = BL_GOOSET;
       static long bl_log_gonoff_set_rx = 0;
       long cnt = ++bl_log_gonoff_set_rx;
-      BL_gooset *pay = &post.pay.gooset;
+      BL_gooset gooset = {0};
+      BL_gooset *pay = &gooset;
     #endif
 
     uint8_t tid, onoff, tt, delay;
@@ -428,10 +567,7 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
     }
 
   	now = k_uptime_get();
-  	if (ctl->last_tid == tid &&
-  	    ctl->last_src_addr == ctx->addr &&
-  	    ctl->last_dst_addr == ctx->recv_dst &&
-  	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC)))
+  	if (bl_dejavu(model, ctx, tid, now))
     {
   		(void)gen_onoff_get(model, ctx, buf);
       LOG(5,BL_Y "ignore #%d repeat tid",tid);
@@ -468,12 +604,9 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
     #endif
 
   	ctl->transition->counter = 0U;
-  	k_timer_stop(&ctl->transition->timer);
+  	transition_stop(ctl->transition);
 
-  	ctl->last_tid = tid;
-  	ctl->last_src_addr = ctx->addr;
-  	ctl->last_dst_addr = ctx->recv_dst;
-  	ctl->last_msg_timestamp = now;
+  	bl_dejavu_add(model, ctx, tid, now);
   	ctl->transition->tt = tt;
   	ctl->transition->delay = delay;
   	ctl->transition->type = NON_MOVE;
@@ -505,7 +638,7 @@ SUBMIT:  dummy = 1;                    // need this in order to use label
       bool dummy = 0;
   SUBMIT:  dummy = 1;                    // need this in order to use label
       BL_ob oo = {BL_AUG(_GOOSRV),STS_,1,NULL};
-      goo_submit(&oo, pay, true, "goosrv:set:");
+      goo_submit(&oo, pay, 0, true, "goosrv:set:");
     #endif
     return 0;
   }
@@ -539,6 +672,11 @@ static int gen_onoff_status(struct bt_mesh_model *model,
 				 struct net_buf_simple *buf)
 	{
 		struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 5 + 4);
+		atomic_val_t epoch = atomic_get(&status_epoch);
+
+		if (status_cached(&level_status, model, ctx)) {
+			return 0;
+		}
 
 		bt_mesh_model_msg_init(msg, BT_MESH_MODEL_OP_GEN_LEVEL_STATUS);
 		net_buf_simple_add_le16(msg, (int16_t) get_current(LEVEL_LIGHT));
@@ -554,6 +692,8 @@ static int gen_onoff_status(struct bt_mesh_model *model,
 		}
 
 	send:
+		status_store(&level_status, epoch, msg);
+
 		if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 			LOG(5,"Unable to send GEN_LEVEL_SRV Status response");
 		}
@@ -601,10 +741,7 @@ static int gen_level_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -626,12 +763,9 @@ static int gen_level_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -667,10 +801,7 @@ static int gen_level_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)gen_level_get(model, ctx, buf);
 		return 0;
 	}
@@ -693,12 +824,9 @@ static int gen_level_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -737,10 +865,7 @@ static int gen_delta_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 
 		if (ctl->light->delta == delta) {
 			return 0;
@@ -770,12 +895,9 @@ static int gen_delta_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -819,10 +941,7 @@ static int gen_delta_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 
 		if (ctl->light->delta == delta) {
 			(void)gen_level_get(model, ctx, buf);
@@ -853,12 +972,9 @@ static int gen_delta_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -904,10 +1020,7 @@ static int gen_move_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -929,12 +1042,9 @@ static int gen_move_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -978,10 +1088,7 @@ static int gen_move_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)gen_level_get(model, ctx, buf);
 		return 0;
 	}
@@ -1004,12 +1111,9 @@ static int gen_move_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -1281,17 +1385,11 @@ static int vnd_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (state->last_tid == tid &&
-	    state->last_src_addr == ctx->addr &&
-	    state->last_dst_addr == ctx->recv_dst &&
-	    (now - state->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
-	state->last_tid = tid;
-	state->last_src_addr = ctx->addr;
-	state->last_dst_addr = ctx->recv_dst;
-	state->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	state->current = current;
 
 	LOG(5,"Vendor model message = %04x", state->current);
@@ -1310,6 +1408,152 @@ static int vnd_set(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 	return 0;
 }
 
+//==============================================================================
+// helper: drive the root generic on/off server (element 0, @1) from a bulk
+// update - same state machine as gen_onoff_set_unack(), with the transition
+// starting at network time <at> (0: after delay)
+//==============================================================================
+
+static void bulk_onoff(uint8_t onoff, uint8_t tt, uint8_t delay, int64_t at)
+{
+	ctl->transition->counter = 0U;
+	transition_stop(ctl->transition);
+
+	ctl->transition->tt = tt;
+	ctl->transition->delay = delay;
+	ctl->transition->at = at;
+	ctl->transition->type = NON_MOVE;
+	set_target(ONOFF, &onoff);
+
+	if (ctl->light->target == ctl->light->current) {
+		ctl->transition->at = 0;
+		return;
+	}
+
+	set_transition_values(ONOFF);
+
+	/* For Instantaneous Transition */
+	if (ctl->transition->counter == 0U) {
+		ctl->light->current = ctl->light->target;
+	}
+
+	ctl->transition->just_started = true;
+	gen_onoff_publish(&root_models[2]);
+	onoff_handler();
+}
+
+//==============================================================================
+// vendor bulk update: one message sets the on/off state of up to 32 elements
+// - payload: mask, states (both le16 or le32), TID, [TT, delay [, start]]
+// - bit 0 drives the root generic on/off server (light state) like a GOOLET
+// - every element selected by mask is notified as [#GOOSRV:STS @ix,...]
+//==============================================================================
+
+static int vnd_bulk_set_unack(struct bt_mesh_model *model,
+			      struct bt_mesh_msg_ctx *ctx,
+			      struct net_buf_simple *buf)
+{
+	uint32_t mask, states;
+	uint8_t tid, tt, delay;
+	uint16_t net;
+	int64_t now, at = 0;
+
+	if (buf->len >= 9) {    /* 32-bit mask and states */
+		mask = net_buf_simple_pull_le32(buf);
+		states = net_buf_simple_pull_le32(buf);
+	} else {                /* 16-bit mask and states */
+		mask = net_buf_simple_pull_le16(buf);
+		states = net_buf_simple_pull_le16(buf);
+	}
+	tid = net_buf_simple_pull_u8(buf);
+
+	now = k_uptime_get();
+	if (bl_dejavu(model, ctx, tid, now)) {
+		return 0;
+	}
+
+	switch (buf->len) {
+	case 0x00:      /* No optional fields are available */
+		tt = ctl->tt;
+		delay = 0U;
+		break;
+	case 0x02:      /* Optional fields are available */
+		tt = net_buf_simple_pull_u8(buf);
+		if ((tt & 0x3F) == 0x3F) {
+			return 0;
+		}
+
+		delay = net_buf_simple_pull_u8(buf);
+		break;
+	case 0x04:      /* TT, delay and network start time */
+		tt = net_buf_simple_pull_u8(buf);
+		if ((tt & 0x3F) == 0x3F) {
+			return 0;
+		}
+
+		delay = net_buf_simple_pull_u8(buf);
+		net = net_buf_simple_pull_le16(buf);
+		if (bl_net_synced()) {  /* expand to full network time */
+			at = bl_net_ms();
+			at += (int16_t)(net - (uint16_t)at);
+		}                       /* otherwise fall back to delay */
+		break;
+	default:
+		return 0;
+	}
+
+	bl_dejavu_add(model, ctx, tid, now);
+
+	LOG(4,BL_M "rcv: [VNDSRV:BULK <#%d>,mask:%08x,states:%08x]",
+	    tid, mask, states);
+
+	if (mask & BIT(0)) {
+		bulk_onoff((states & BIT(0)) ? STATE_ON : STATE_OFF, tt, delay, at);
+	}
+
+  #if MIGRATION_STEP6                  // decode into per element updates
+	for (int i = 0; i < VND_BULK_ELEMENTS; i++) {
+		if (!(mask & BIT(i))) {
+			continue;
+		}
+
+		BL_gooset pay = {
+			.target = (states >> i) & 1,
+			.tid = tid,
+			.tt = tt,
+			.delay = delay,
+		};
+		BL_ob oo = {BL_AUG(_GOOSRV),STS_,i+1,NULL};
+		goo_submit(&oo, &pay, at, false, "vndsrv:bulk:");
+	}
+  #endif
+
+	return 0;
+}
+
+/* Network time beacon: estimate the network time at receipt by adding the
+ * relay latency of each hop the beacon has travelled.
+ */
+static int vnd_time_beacon(struct bt_mesh_model *model,
+			   struct bt_mesh_msg_ctx *ctx,
+			   struct net_buf_simple *buf)
+{
+	int64_t net;
+	uint8_t ttl;
+	int hops, syncs, err;
+
+	net = net_buf_simple_pull_le48(buf);
+	ttl = net_buf_simple_pull_u8(buf);
+
+	hops = (ttl > ctx->recv_ttl) ? ttl - ctx->recv_ttl : 0;
+	bl_net_sync(net + hops * CFG_NETTIME_HOP_MS);
+
+	bl_net_stats(&syncs, &err);
+	LOG(4,BL_M "rcv: [VNDSRV:TIME %d ms], hops: %d, err: %d ms (#%d)",
+	    (int)net, hops, err, syncs);
+	return 0;
+}
+
 static int vnd_status(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
 		      struct net_buf_simple *buf)
 {
@@ -1326,6 +1570,11 @@ static int light_lightness_get(struct bt_mesh_model *model,
 			       struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 5 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&lightness_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg, BT_MESH_MODEL_LIGHT_LIGHTNESS_STATUS);
 	net_buf_simple_add_le16(msg, (uint16_t) get_current(ACTUAL));
@@ -1341,6 +1590,8 @@ static int light_lightness_get(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&lightness_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send LightLightnessAct Status response");
 	}
@@ -1384,10 +1635,7 @@ static int light_lightness_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -1409,12 +1657,9 @@ static int light_lightness_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1450,10 +1695,7 @@ static int light_lightness_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)light_lightness_get(model, ctx, buf);
 		return 0;
 	}
@@ -1476,12 +1718,9 @@ static int light_lightness_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1512,6 +1751,11 @@ static int light_lightness_linear_get(struct bt_mesh_model *model,
 				      struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 5 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&linear_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg,
 			       BT_MESH_MODEL_LIGHT_LIGHTNESS_LINEAR_STATUS);
@@ -1528,6 +1772,8 @@ static int light_lightness_linear_get(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&linear_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send LightLightnessLin Status response");
 	}
@@ -1572,10 +1818,7 @@ static int light_lightness_linear_set_unack(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -1597,12 +1840,9 @@ static int light_lightness_linear_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1638,10 +1878,7 @@ static int light_lightness_linear_set(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)light_lightness_linear_get(model, ctx, buf);
 		return 0;
 	}
@@ -1664,12 +1901,9 @@ static int light_lightness_linear_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -1972,6 +2206,11 @@ static int light_ctl_get(struct bt_mesh_model *model,
 			 struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 9 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&ctl_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg, BT_MESH_MODEL_LIGHT_CTL_STATUS);
 	net_buf_simple_add_le16(msg, (uint16_t) get_current(CTL_LIGHT));
@@ -1990,6 +2229,8 @@ static int light_ctl_get(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&ctl_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send LightCTL Status response");
 	}
@@ -2046,10 +2287,7 @@ static int light_ctl_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -2071,12 +2309,9 @@ static int light_ctl_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2125,10 +2360,7 @@ static int light_ctl_set(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)light_ctl_get(model, ctx, buf);
 		return 0;
 	}
@@ -2151,12 +2383,9 @@ static int light_ctl_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2480,6 +2709,11 @@ static int light_ctl_temp_get(struct bt_mesh_model *model,
 			      struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 9 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&ctl_temp_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg, BT_MESH_MODEL_LIGHT_CTL_TEMP_STATUS);
 	net_buf_simple_add_le16(msg, (uint16_t) get_current(CTL_TEMP));
@@ -2498,6 +2732,8 @@ static int light_ctl_temp_get(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&ctl_temp_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send LightCTL Temp. Status response");
 	}
@@ -2549,10 +2785,7 @@ static int light_ctl_temp_set_unack(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -2574,12 +2807,9 @@ static int light_ctl_temp_set_unack(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2624,10 +2854,7 @@ static int light_ctl_temp_set(struct bt_mesh_model *model,
 	}
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)light_ctl_temp_get(model, ctx, buf);
 		return 0;
 	}
@@ -2650,12 +2877,9 @@ static int light_ctl_temp_set(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2690,6 +2914,11 @@ static int gen_level_get_temp(struct bt_mesh_model *model,
 			      struct net_buf_simple *buf)
 {
 	struct net_buf_simple *msg = NET_BUF_SIMPLE(2 + 5 + 4);
+	atomic_val_t epoch = atomic_get(&status_epoch);
+
+	if (status_cached(&level_temp_status, model, ctx)) {
+		return 0;
+	}
 
 	bt_mesh_model_msg_init(msg, BT_MESH_MODEL_OP_GEN_LEVEL_STATUS);
 	net_buf_simple_add_le16(msg, (int16_t) get_current(LEVEL_TEMP));
@@ -2705,6 +2934,8 @@ static int gen_level_get_temp(struct bt_mesh_model *model,
 	}
 
 send:
+	status_store(&level_temp_status, epoch, msg);
+
 	if (bt_mesh_model_send(model, ctx, msg, NULL, NULL)) {
 		LOG(5,"Unable to send GEN_LEVEL_SRV Status response");
 	}
@@ -2748,10 +2979,7 @@ static int gen_level_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -2773,12 +3001,9 @@ static int gen_level_set_unack_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2814,10 +3039,7 @@ static int gen_level_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)gen_level_get_temp(model, ctx, buf);
 		return 0;
 	}
@@ -2840,12 +3062,9 @@ static int gen_level_set_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2884,10 +3103,7 @@ static int gen_delta_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 
 		if (ctl->temp->delta == delta) {
 			return 0;
@@ -2917,12 +3133,9 @@ static int gen_delta_set_unack_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -2966,10 +3179,7 @@ static int gen_delta_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 
 		if (ctl->temp->delta == delta) {
 			(void)gen_level_get_temp(model, ctx, buf);
@@ -3000,12 +3210,9 @@ static int gen_delta_set_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = NON_MOVE;
@@ -3051,10 +3258,7 @@ static int gen_move_set_unack_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		return 0;
 	}
 
@@ -3076,12 +3280,9 @@ static int gen_move_set_unack_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -3126,10 +3327,7 @@ static int gen_move_set_temp(struct bt_mesh_model *model,
 	tid = net_buf_simple_pull_u8(buf);
 
 	now = k_uptime_get();
-	if (ctl->last_tid == tid &&
-	    ctl->last_src_addr == ctx->addr &&
-	    ctl->last_dst_addr == ctx->recv_dst &&
-	    (now - ctl->last_msg_timestamp <= (6 * MSEC_PER_SEC))) {
+	if (bl_dejavu(model, ctx, tid, now)) {
 		(void)gen_level_get_temp(model, ctx, buf);
 		return 0;
 	}
@@ -3152,12 +3350,9 @@ static int gen_move_set_temp(struct bt_mesh_model *model,
 	}
 
 	ctl->transition->counter = 0U;
-	k_timer_stop(&ctl->transition->timer);
+	transition_stop(ctl->transition);
 
-	ctl->last_tid = tid;
-	ctl->last_src_addr = ctx->addr;
-	ctl->last_dst_addr = ctx->recv_dst;
-	ctl->last_msg_timestamp = now;
+	bl_dejavu_add(model, ctx, tid, now);
 	ctl->transition->tt = tt;
 	ctl->transition->delay = delay;
 	ctl->transition->type = MOVE;
@@ -3364,6 +3559,8 @@ static const struct bt_mesh_model_op vnd_ops[] = {
 	{ BT_MESH_MODEL_OP_3(0x02, CID_ZEPHYR), BT_MESH_LEN_EXACT(3), vnd_set },
 	{ BT_MESH_MODEL_OP_3(0x03, CID_ZEPHYR), BT_MESH_LEN_EXACT(3), vnd_set_unack },
 	{ BT_MESH_MODEL_OP_3(0x04, CID_ZEPHYR), BT_MESH_LEN_EXACT(6), vnd_status },
+	{ BT_MESH_MODEL_OP_VND_BULK_SET_UNACK,  BT_MESH_LEN_MIN(5),   vnd_bulk_set_unack },
+	{ BT_MESH_MODEL_OP_VND_TIME_BEACON,     BT_MESH_LEN_EXACT(7), vnd_time_beacon },
 	BT_MESH_MODEL_OP_END,
 };
 
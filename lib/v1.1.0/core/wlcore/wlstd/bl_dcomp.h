@@ -61,6 +61,19 @@
 
 #define CID_ZEPHYR 0x0002
 
+/* Vendor bulk on/off update: mask, states, TID, [TT, delay]
+ * or mask, states, TID, TT, delay, network start time (le16, low 16 bits of
+ * ms; receivers without network time fall back to the delay)
+ * mask and states are le16 (elements 1..16, unsegmented PDU) or le32
+ * (elements 1..32, always with network start time), told apart by the
+ * payload length (5/7 vs 9/11/13)
+ */
+#define BT_MESH_MODEL_OP_VND_BULK_SET_UNACK	BT_MESH_MODEL_OP_3(0x05, CID_ZEPHYR)
+#define VND_BULK_ELEMENTS	32	/* elements addressable by a bulk update */
+
+/* Vendor time beacon: network time (le48, ms), initial TTL */
+#define BT_MESH_MODEL_OP_VND_TIME_BEACON	BT_MESH_MODEL_OP_3(0x06, CID_ZEPHYR)
+
 #define STATE_OFF       0x00
 #define STATE_ON        0x01
 #define STATE_DEFAULT   0x01
@@ -81,10 +94,6 @@
 struct vendor_state {
 	int current;
 	uint32_t response;
-	uint8_t last_tid;
-	uint16_t last_src_addr;
-	uint16_t last_dst_addr;
-	int64_t last_msg_timestamp;
 };
 
 struct lightness {
@@ -133,11 +142,6 @@ struct light_ctl_state {
 
 	uint8_t onpowerup, tt;
 
-	uint8_t last_tid;
-	uint16_t last_src_addr;
-	uint16_t last_dst_addr;
-	int64_t last_msg_timestamp;
-
 	struct transition *transition;
 };
 
@@ -158,6 +162,9 @@ void light_ctl_publish(struct bt_mesh_model *model);
 void light_ctl_temp_publish(struct bt_mesh_model *model);
 void gen_level_publish_temp(struct bt_mesh_model *model);
 
+void status_invalidate(void);	/* drop cached GET status PDUs */
+void status_cache_stats(uint32_t *hits, uint32_t *misses);
+
 //==============================================================================
 // public module interface
 //==============================================================================
@@ -0,0 +1,111 @@
+//==============================================================================
+// bl_lmath.c
+// integer lighting math (lightness and temperature conversions)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+
+  #include "bl_lmath.h"
+
+//==============================================================================
+// integer square root
+// - bit-by-bit method: 16 iterations of shift/add/compare, no division
+// - returns floor(sqrt(x)) for any 32-bit x
+//==============================================================================
+
+  uint16_t bl_isqrt(uint32_t x)
+  {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;          // highest power of four <= 2^32
+
+    while (bit > x)
+      bit >>= 2;
+
+    while (bit != 0)
+    {
+      if (x >= root + bit)
+      {
+        x -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else
+        root >>= 1;
+
+      bit >>= 2;
+    }
+
+    return (uint16_t)root;
+  }
+
+//==============================================================================
+// lightness actual -> linear: ceil(act^2 / 65535)
+// - act^2 + 65534 <= 0xFFFEFFFF, so 32-bit unsigned math is sufficient
+//==============================================================================
+
+  uint16_t bl_act2lin(uint16_t act)
+  {
+    uint32_t sq = (uint32_t)act * act;
+    return (uint16_t)((sq + (UINT16_MAX-1)) / UINT16_MAX);
+  }
+
+//==============================================================================
+// lightness linear -> actual: 65535 * sqrt(lin/65535) = sqrt(lin * 65535)
+//==============================================================================
+
+  uint16_t bl_lin2act(uint16_t lin)
+  {
+    return bl_isqrt((uint32_t)lin * UINT16_MAX);
+  }
+
+//==============================================================================
+// CTL temperature -> generic level
+// - temperatures outside [tmin,tmax] are saturated, an empty range maps to
+//   the minimum level
+//==============================================================================
+
+  int16_t bl_temp2level(uint16_t temp, uint16_t tmin, uint16_t tmax)
+  {
+    if (tmax <= tmin || temp <= tmin)
+      return INT16_MIN;
+    if (temp >= tmax)
+      temp = tmax;
+
+    uint32_t num = (uint32_t)(temp - tmin) * UINT16_MAX;
+    return (int16_t)((int32_t)(num / (uint32_t)(tmax - tmin)) + INT16_MIN);
+  }
+
+//==============================================================================
+// generic level -> CTL temperature
+//==============================================================================
+
+  uint16_t bl_level2temp(int16_t level, uint16_t tmin, uint16_t tmax)
+  {
+    if (tmax <= tmin)
+      return tmin;
+
+    uint32_t num = (uint32_t)(level - INT16_MIN) * (uint32_t)(tmax - tmin);
+    return (uint16_t)(tmin + num / UINT16_MAX);
+  }
+
+//==============================================================================
+// batch conversions (multi element nodes)
+//==============================================================================
+
+  void bl_act2lin_n(const uint16_t *act, uint16_t *lin, int n)
+  {
+    for (int i=0; i < n; i++)
+      lin[i] = bl_act2lin(act[i]);
+  }
+
+  void bl_lin2act_n(const uint16_t *lin, uint16_t *act, int n)
+  {
+    for (int i=0; i < n; i++)
+      act[i] = bl_lin2act(lin[i]);
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
@@ -0,0 +1,57 @@
+//==============================================================================
+// bl_lmath.h
+// integer lighting math (lightness and temperature conversions)
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluccino. All rights reserved.
+//==============================================================================
+// all conversions are pure integer math (no float, no soft-float library),
+// and results are exact with respect to the Mesh Model Specification
+// formulas for each of the 65536 possible inputs:
+//
+//   Linear = ceil(65535 * (Actual/65535)^2)              (MshMDL 6.1.2.2.1)
+//   Actual = 65535 * sqrt(Linear/65535)                  (MshMDL 6.1.2.2.1)
+//   Level  = (T-Tmin) * 65535 / (Tmax-Tmin) - 32768      (MshMDL 6.1.3.1.1)
+//   T      = Tmin + (Level+32768) * (Tmax-Tmin) / 65535  (MshMDL 6.1.3.1.1)
+//==============================================================================
+
+#ifndef __BL_LMATH_H__
+#define __BL_LMATH_H__
+
+  #include <stdint.h>
+
+//==============================================================================
+// integer square root
+// - usage: root = bl_isqrt(x)    // floor(sqrt(x)) for any 32-bit x
+//==============================================================================
+
+  uint16_t bl_isqrt(uint32_t x);
+
+//==============================================================================
+// lightness actual <-> lightness linear
+// - usage: lin = bl_act2lin(act)  // Light Lightness Actual to Linear
+//          act = bl_lin2act(lin)  // Light Lightness Linear to Actual
+//==============================================================================
+
+  uint16_t bl_act2lin(uint16_t act);
+  uint16_t bl_lin2act(uint16_t lin);
+
+//==============================================================================
+// CTL temperature <-> generic level
+// - usage: level = bl_temp2level(temp,tmin,tmax)  // temperature to level
+//          temp = bl_level2temp(level,tmin,tmax)  // level to temperature
+//==============================================================================
+
+  int16_t bl_temp2level(uint16_t temp, uint16_t tmin, uint16_t tmax);
+  uint16_t bl_level2temp(int16_t level, uint16_t tmin, uint16_t tmax);
+
+//==============================================================================
+// batch conversions (multi element nodes)
+// - usage: bl_act2lin_n(act,lin,n)  // convert n lightness values
+//          bl_lin2act_n(lin,act,n)  // convert n lightness values
+//==============================================================================
+
+  void bl_act2lin_n(const uint16_t *act, uint16_t *lin, int n);
+  void bl_lin2act_n(const uint16_t *lin, uint16_t *act, int n);
+
+#endif // __BL_LMATH_H__
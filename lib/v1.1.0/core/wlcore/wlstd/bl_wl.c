@@ -16,11 +16,13 @@
 //==============================================================================
 
   #include "bl_deco.c"                 // Bluccino log decoration
+  #include "bl_boot.c"                 // boot phase profiling
   #include "bl_mesh.c"
   #include "ble_mesh.c"
   #include "bl_dcomp.c"
   #include "notrans.c"
   #include "publisher.c"
+  #include "bl_lmath.c"
   #include "state_binding.c"
   #include "storage.c"
   #include "transition.c"
@@ -35,6 +37,7 @@
 
   #include "bluccino.h"
 
+  #include "bl_boot.h"
   #include "bl_core.h"
   #include "bl_dcomp.h"
   #include "bl_gonoff.h"
@@ -47,6 +50,7 @@
   #include "storage.h"
   #include "transition.h"
   #include "publisher.h"
+  #include "bl_trans.h"
 
 //==============================================================================
 // CORE level logging shorthands
@@ -165,6 +169,7 @@ void update_vnd_led_gpio(void)
 
   void update_light_state(void)
   {
+	  status_invalidate();               // cached GET status is outdated
 	  update_led_gpio();
 
 	  if (ctl->transition->counter == 0 || reset == false)
@@ -186,6 +191,7 @@ void update_vnd_led_gpio(void)
     static BL_oval S = bl_storage;     // NVM storage module
     static BL_oval W = bl_wl;          // wireless core
 
+    bl_boot(BOOT_WL_INIT);
     light_default_var_init();
 
     #if defined(CONFIG_MCUMGR)
@@ -199,11 +205,10 @@ void update_vnd_led_gpio(void)
       // NVM module and BLE/mesh module to be registered in wireless core
 
     bl_init((S),(W));                  // init NVM, output => bl_wl()
-    bl_init((B),(W));                  // output of BLE_MESH goes to here!
+    bl_init((B),(W));                  // async BT enable, [MESH:READY] follows
 
-    light_default_status_init();
-
-    update_light_state();
+      // light status init depends on settings_load() and is therefore
+      // deferred until [MESH:READY] (see mesh_ready())
 
     bl_init((R),(W));
 
@@ -213,6 +218,23 @@ void update_vnd_led_gpio(void)
 
       k_timer_start(&smp_svr_timer, K_NO_WAIT, K_MSEC(1000));
     #endif
+
+    bl_boot(BOOT_WL_DONE);
+    return 0;                          // OK
+  }
+
+//==============================================================================
+// worker: BLE/mesh is ready (settings loaded, provisioning enabled)
+// - val = 0: BT/mesh init failed, the light still starts without mesh
+//==============================================================================
+
+  static int mesh_ready(BL_ob *o, int val)
+  {
+    if (!val)
+      LOG(1,BL_R "no mesh: starting light without Bluetooth mesh");
+
+    light_default_status_init();       // only after settings_load()
+    update_light_state();
     return 0;                          // OK
   }
 
@@ -236,6 +258,7 @@ void update_vnd_led_gpio(void)
 //                  |       MESH:        | MESH lower interface
 // (B)->      PRV ->|       onoff        | provision on/off
 // (B)->      ATT ->|       onoff        | attention on/off
+// (B)->    READY ->|        ok          | mesh ready (ok=1) or failed (ok=0)
 //                  +--------------------+
 //                  |       RESET:       | RESET input interface
 // (!)->      INC ->|         ms         | inc reset counter & set due timer
@@ -252,6 +275,7 @@ void update_vnd_led_gpio(void)
 // (!)->    STORE ->|      @ix,val       | store value in NVM at location @ix
 // (!)->   RECALL ->|        @ix         | recall value in NVM at location @ix
 // (!)->     SAVE ->|                    | save NVM cache to NVM
+// (!)->    FLUSH ->|                    | flush pending NVM writes
 //                  |....................|
 //                  |        NVM:        | NVM: lower interface
 // (N)->    READY ->|       ready        | notification that NVM is now ready
@@ -295,6 +319,8 @@ void update_vnd_led_gpio(void)
         return 0;                      // OK - nothing to tick/tock
 
       case SYS_TOCK_ix_BL_pace_cnt:    // [SYS:TICK @0,cnt]
+        if (CFG_NETTIME_MASTER && prv && val % CFG_NETTIME_PERIOD == 0)
+          bl_pub_time();               // publish network time beacon
         return bl_fwd(o,val,(S));      // bl_storage module to be tocked
 
       case MESH_PRV_0_0_sts:           // (B)->[MESH:PRV sts]->(O)  (provision)
@@ -307,6 +333,9 @@ void update_vnd_led_gpio(void)
         att = val;
         return bl_out(o,val,(U));      // output to subscriber
 
+      case MESH_READY_0_0_1:           // (B)->[MESH:READY ok] (BT/mesh ready)
+        return mesh_ready(o,val);      // deferred light status init
+
       case RESET_INC_0_0_ms:           // cnt = [RESET:INC <ms>]
       case RESET_PRV_0_0_0:
         return bl_fwd(o,val,(R));      // forward to bl_reset module
@@ -329,6 +358,7 @@ void update_vnd_led_gpio(void)
       case NVM_RECALL_ix_0_0:
       case NVM_SAVE_0_BL_tray_0:
       case NVM_LOAD_0_BL_tray_0:
+      case NVM_FLUSH_0_0_0:
       case NVM_SUPPORT_0_0_0:
         return bl_fwd(o,val,(S));      // forward to bl_storage module
 
@@ -6,7 +6,9 @@
  */
 
   #include "ble_mesh.h"
+  #include "bl_boot.h"
   #include "bl_dcomp.h"
+  #include "storage.h"
 
   #include "bluccino.h"
   #include "bl_wl.h"
@@ -112,27 +114,58 @@ static int output_string(const char *str)
   	.reset = prov_reset,
   };
 
+//==============================================================================
+// helper: Bluetooth/mesh init failed
+// - NVM is usable without Bluetooth, so it is made ready anyway, and the
+//   remaining boot phases are marked as skipped to complete the report
+// - [#MESH:READY 0] lets the core run its local light init without mesh
+//==============================================================================
+
+  static void bt_abort(int err, BL_txt msg)
+  {
+    bl_err(err,msg);
+    storage_fallback();                // [NVM:READY] without settings_load()
+
+    for (int p=BOOT_BT_READY; p < BOOT_PHASES; p++)
+      if (p != BOOT_NVM_READY)         // stamped by storage when ready
+        bl_boot_skip(p);
+
+    _bl_msg(ble_mesh,_MESH,READY_, 0,NULL,0);   // (BL_WL) <- [#MESH:READY 0]
+  }
+
 //==============================================================================
 // callback: Bluetooth is ready
+// - called asynchronously by bt_enable(), overlapping the remaining core init
+// - posts [#MESH:READY] once settings are loaded and provisioning is enabled
 //==============================================================================
 
-  void bt_ready(void)
+  static void bt_ready(int err)
   {
-  	int err;
   	struct bt_le_oob oob;
 
+  	if (err)
+  	{
+  	  bt_abort(err,"Bluetooth init failed");
+  		return;
+  	}
+
+  	bl_boot(BOOT_BT_READY);
   	LOG(4,BL_B "Bluetooth initialized");
 
   	err = bt_mesh_init(&prov, &comp);
   	if (err)
   	{
-  	  bl_err(err,"initializing mesh failed");
+  	  bt_abort(err,"initializing mesh failed");
   		return;
   	}
+  	bl_boot(BOOT_MESH_INIT);
 
   	if (IS_ENABLED(CONFIG_SETTINGS)) {
   		settings_load();
+  	} else {
+  		storage_fallback();
   	}
+  	bl_boot(BOOT_SETTINGS);
 
   	  // use identity address as device UUID
 
@@ -146,7 +179,10 @@ LOG(3,BL_B "device UUID: [%02X%02X:%02X%02X:%02X%02X]",
     }
 
   	bt_mesh_prov_enable(BT_MESH_PROV_GATT | BT_MESH_PROV_ADV);
+  	bl_boot(BOOT_PROV_ENABLE);
     LOG(4,BL_B"mesh initialized");
+
+    _bl_msg(ble_mesh,_MESH,READY_, 0,NULL,1);   // (BL_WL) <- [#MESH:READY 1]
   }
 
 //==============================================================================
@@ -157,16 +193,16 @@ LOG(3,BL_B "device UUID: [%02X%02X:%02X%02X:%02X%02X]",
   {
     LOG(3,BL_C "init BLE/Mesh...");
 
-      // init Bluetooth subsystem
+      // init Bluetooth subsystem (async: bt_ready() will be called back)
 
-    int err = bt_enable(NULL);
+    bl_boot(BOOT_BT_ENABLE);
+    int err = bt_enable(bt_ready);
     if (err)
     {
-      bl_err(err,"Bluetooth init failed");
+      bt_abort(err,"Bluetooth init failed");
       return err;
     }
 
-    bt_ready();
     return 0;                            // OK
   }
 
@@ -184,10 +220,12 @@ LOG(3,BL_B "device UUID: [%02X%02X:%02X%02X:%02X%02X]",
 //                  |       MESH:        | MESH: public interface
 // (O)<-      PRV <-|       onoff        | provision on/off
 // (O)<-      ATT <-|       onoff        | attention on/off
+// (O)<-    READY <-|        ok          | mesh ready (ok=1) or failed (ok=0)
 //                  +====================+
 //                  |      #MESH:        | MESH: private interface
 // (#)->      PRV ->|       onoff        | provision on/off
 // (#)->      ATT ->|       onoff        | attention on/off
+// (#)->    READY ->|        ok          | mesh ready (ok=1) or failed (ok=0)
 //                  +--------------------+
 //
 //==============================================================================
@@ -204,6 +242,7 @@ LOG(3,BL_B "device UUID: [%02X%02X:%02X%02X:%02X%02X]",
 
       case _BL_ID(_MESH,PRV_):         // [#SET:PRV val]  (provision)
       case _BL_ID(_MESH,ATT_):         // [#SET:ATT val]  (attention)
+      case _BL_ID(_MESH,READY_):       // [#MESH:READY ok] (BT/mesh ready)
 //      LOGO(3,BL_G,o,val);
         return bl_out(o,val,(W));      // output to subscriber
 
@@ -65,6 +65,7 @@ static void no_transition_work_handler(struct k_work *work)
 	}
 
 	if (readjust_light_state) {
+		status_invalidate();
 		update_led_gpio();
 	}
 
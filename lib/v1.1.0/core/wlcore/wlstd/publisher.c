@@ -14,6 +14,7 @@
 #include "bluccino.h"
 #include "bl_mesh.h"
 #include "bl_gonoff.h"
+#include "bl_trans.h"
 
 //==============================================================================
 // CORE level logging shorthands
@@ -259,6 +260,190 @@ LOG(4,BL_G"snd [GOOCLI:LET @1,0]");
 }
 #endif
 
+//==============================================================================
+// publication buffer pool
+// - publishes no longer go through the model's static publication message,
+//   thus several publishes (e.g. spooled repeats) can be in flight at once
+// - a buffer stays acquired until its publication (incl. retransmits) ends
+//==============================================================================
+
+  #ifndef CFG_PUB_POOL
+    #define CFG_PUB_POOL   4           // number of publication buffers
+  #endif
+
+  #if (CFG_PUB_POOL > 128)
+    #error CFG_PUB_POOL                // max 128 (buffer index in token)
+  #endif
+
+  static BL_msg pub_pool[CFG_PUB_POOL];// publication buffers
+  static ATOMIC_DEFINE(pool_busy,CFG_PUB_POOL);  // buffers in use
+  static atomic_t pool_used;           // number of buffers in use
+  static atomic_t pool_peak = 0;       // max number of buffers in use
+  static atomic_t pool_fails = 0;      // number of failed acquires
+
+  BL_msg *bl_msg_acquire(void)
+  {
+    for (int i=0; i < CFG_PUB_POOL; i++)
+    {
+      if (atomic_test_and_set_bit(pool_busy,i))
+        continue;                      // buffer in use
+
+      atomic_val_t n = atomic_inc(&pool_used) + 1;
+      atomic_val_t peak = atomic_get(&pool_peak);
+      while (n > peak && !atomic_cas(&pool_peak,peak,n))
+        peak = atomic_get(&pool_peak); // lost race: retry with new peak
+      bl_msg_init(pub_pool+i);
+      return pub_pool + i;
+    }
+
+    atomic_inc(&pool_fails);
+    LOG(1,BL_R "publication pool exhausted (%d buffers)",CFG_PUB_POOL);
+    return NULL;
+  }
+
+  void bl_msg_release(BL_msg *pmsg)
+  {
+    int i = pmsg - pub_pool;
+
+    if (i < 0 || i >= CFG_PUB_POOL || !atomic_test_and_clear_bit(pool_busy,i))
+    {
+      bl_err(-1,"bl_msg_release: bad buffer");
+      return;
+    }
+    atomic_dec(&pool_used);
+  }
+
+  void bl_msg_stats(int *pused, int *ppeak, int *pfails)
+  {
+    *pused = (int)atomic_get(&pool_used);
+    *ppeak = (int)atomic_get(&pool_peak);
+    *pfails = (int)atomic_get(&pool_fails);
+  }
+
+//==============================================================================
+// publish pooled buffer (release buffer when publication ends)
+// - each buffer carries its own publication context (pmsg->pub), a copy of
+//   the model's, so every publish in flight keeps retransmit count/interval,
+//   reliable flag and (virtual) destination address like bt_mesh_model_publish()
+// - a publication is identified by a token (sequence, 0x80, buffer index);
+//   whoever ends the publication first clears the token and releases the
+//   buffer, so a late error callback of a failed send can't release twice
+// - friendship credentials can't be selected by a message context, such
+//   publishes go through the model's own publication
+//==============================================================================
+
+  static atomic_t pool_tx[CFG_PUB_POOL];    // publication token per buffer
+  static atomic_t pool_seq;            // token sequence
+
+  static void pub_finish(int i, atomic_val_t token)
+  {
+    if (atomic_cas(&pool_tx[i],token,0))
+      bl_msg_release(pub_pool+i);      // first one to finish releases
+  }
+
+  static void pub_end(int err, void *data);
+
+  static const struct bt_mesh_send_cb pub_cb =
+  {
+    .end = pub_end,
+  };
+
+  static int pub_send(int i, atomic_val_t token)   // one transmission
+  {
+    BL_msg *pmsg = pub_pool + i;
+    BL_pub *pub = &pmsg->pub;
+
+  #ifdef BT_MESH_MSG_CTX_INIT_PUB
+    struct bt_mesh_msg_ctx ctx = BT_MESH_MSG_CTX_INIT_PUB(pub);  // incl. label
+  #else
+    struct bt_mesh_msg_ctx ctx =       // stack resolves virtual address label
+    {
+      .app_idx = pub->key,
+      .addr = pub->addr,
+      .send_ttl = pub->ttl,
+    };
+  #endif
+    ctx.send_rel = pub->send_rel;
+
+      // the stack appends the MIC to the SDU, thus send a copy (retransmits)
+
+    NET_BUF_SIMPLE_DEFINE(sdu, BL_DNP_DATA_LENGTH + BT_MESH_MIC_SHORT);
+    net_buf_simple_add_mem(&sdu, pmsg->nbs.data, pmsg->nbs.len);
+
+    int err = bt_mesh_model_send(pub->mod, &ctx, &sdu, &pub_cb,
+                                 (void*)(uintptr_t)token);
+    if (err)
+      pub_finish(i,token);             // no (or an early error) callback
+    return err;
+  }
+
+  static void pub_end(int err, void *data)
+  {
+    atomic_val_t token = (atomic_val_t)(uintptr_t)data;
+    int i = token & 0x7F;              // buffer index
+    BL_pub *pub = &pub_pool[i].pub;
+
+    if (atomic_get(&pool_tx[i]) != token)
+      return;                          // publication has ended already
+
+    if (!err && pub->count > 0)        // retransmit after interval
+    {
+      pub->count--;
+      k_work_reschedule(&pub->timer,
+                        K_MSEC(BT_MESH_PUB_TRANSMIT_INT(pub->retransmit)));
+      return;
+    }
+
+    pub_finish(i,token);
+  }
+
+  static void pub_retransmit(struct k_work *work)
+  {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    BL_msg *pmsg = CONTAINER_OF(dwork, BL_msg, pub.timer);
+    int i = pmsg - pub_pool;
+
+    pub_send(i, atomic_get(&pool_tx[i]));
+  }
+
+  int bl_msg_publish(BL_model *pmod, BL_msg *pmsg)
+  {
+    BL_pub *pub = pmod->pub;
+    int i = pmsg - pub_pool;
+
+    if (!pub || pub->addr == BT_MESH_ADDR_UNASSIGNED)
+    {
+      bl_msg_release(pmsg);
+      return -EADDRNOTAVAIL;           // same as bt_mesh_model_publish()
+    }
+
+    if (pub->cred)                     // friendship credentials
+    {
+      int err = -EMSGSIZE;
+      if (pub->msg && pmsg->nbs.len <= pub->msg->size)
+      {
+        net_buf_simple_reset(pub->msg);
+        net_buf_simple_add_mem(pub->msg, pmsg->nbs.data, pmsg->nbs.len);
+        err = bt_mesh_model_publish(pmod);
+      }
+      bl_msg_release(pmsg);
+      return err;
+    }
+
+    pmsg->pub = *pub;                  // buffer's own publication context
+    pmsg->pub.mod = pmod;
+    pmsg->pub.msg = &pmsg->nbs;
+    pmsg->pub.update = NULL;
+    pmsg->pub.count = BT_MESH_PUB_TRANSMIT_COUNT(pub->retransmit);
+    k_work_init_delayable(&pmsg->pub.timer, pub_retransmit);
+
+    atomic_val_t token = (atomic_val_t)
+                         (((uint32_t)atomic_inc(&pool_seq) << 8) | 0x80 | i);
+    atomic_set(&pool_tx[i], token);
+
+    return pub_send(i,token);
+  }
+
 //==============================================================================
 // transmit generic onoff set
 //==============================================================================
@@ -270,14 +455,18 @@ LOG(4,BL_G"snd [GOOCLI:LET @1,0]");
   	      bl_iid(pmod), pmod->elem_idx, pmod->mod_idx,
           msg, bl_ix(o), tid,bl_tt2ms(tt),bl_delay2ms(delay), onoff);
 
-    bt_mesh_model_msg_init(pmod->pub->msg, mid);
+    BL_msg *pmsg = bl_msg_acquire();
+    if (!pmsg)
+      return -ENOBUFS;                 // pool exhausted (already reported)
 
-    net_buf_simple_add_u8(pmod->pub->msg, onoff);
-    net_buf_simple_add_u8(pmod->pub->msg, tid);
-    net_buf_simple_add_u8(pmod->pub->msg, tt);
-    net_buf_simple_add_u8(pmod->pub->msg, delay);
+    bt_mesh_model_msg_init(&pmsg->nbs, mid);
 
-    return bt_mesh_model_publish(pmod);
+    net_buf_simple_add_u8(&pmsg->nbs, onoff);
+    net_buf_simple_add_u8(&pmsg->nbs, tid);
+    net_buf_simple_add_u8(&pmsg->nbs, tt);
+    net_buf_simple_add_u8(&pmsg->nbs, delay);
+
+    return bl_msg_publish(pmod, pmsg);
   }
 
 //==============================================================================
@@ -301,6 +490,77 @@ LOG(4,BL_G"snd [GOOCLI:LET @1,0]");
     return bt_mesh_model_publish(pmod);
   }
 */
+//==============================================================================
+// vendor bulk update publisher (one message instead of N GOOCLI publishes)
+//==============================================================================
+
+  int bl_pub_bulk(uint32_t mask, uint32_t states, BL_byte tt, BL_byte delay)
+  {
+    static BL_byte tid = 0;            // must be static
+
+    BL_msg *pmsg = bl_msg_acquire();
+    if (!pmsg)
+      return -ENOBUFS;                 // pool exhausted (already reported)
+
+    tid++;
+    LOG(4,BL_G "pub: [VNDCLI:BULK <#%d,/%d,&%d>,mask:%08x,states:%08x]",
+               tid, bl_tt2ms(tt), bl_delay2ms(delay), mask, states);
+
+    bt_mesh_model_msg_init(&pmsg->nbs, BT_MESH_MODEL_OP_VND_BULK_SET_UNACK);
+
+    bool synced = bl_net_synced();
+
+    if (mask > 0xFFFF || synced)       // elements @17..@32 or start time?
+    {
+      net_buf_simple_add_le32(&pmsg->nbs, mask);
+      net_buf_simple_add_le32(&pmsg->nbs, states);
+    }
+    else                               // short form: unsegmented PDU
+    {
+      net_buf_simple_add_le16(&pmsg->nbs, (uint16_t)mask);
+      net_buf_simple_add_le16(&pmsg->nbs, (uint16_t)states);
+    }
+    net_buf_simple_add_u8(&pmsg->nbs, tid);
+    net_buf_simple_add_u8(&pmsg->nbs, tt);
+    net_buf_simple_add_u8(&pmsg->nbs, delay);
+
+      // with network time the network start time (low 16 bits) follows, so
+      // all synced receivers begin at the same instant; receivers without
+      // network time use the delay (the 32-bit form keeps lengths distinct)
+
+    if (synced)
+      net_buf_simple_add_le16(&pmsg->nbs,
+                    (uint16_t)(bl_net_ms() + bl_delay2ms(delay)));
+
+    return bl_msg_publish(&vnd_models[0], pmsg);
+  }
+
+//==============================================================================
+// vendor time beacon publisher (network time source only)
+//==============================================================================
+
+  int bl_pub_time(void)
+  {
+    BL_model *pmod = &vnd_models[0];
+    BL_pub *pub = pmod->pub;
+
+    BL_msg *pmsg = bl_msg_acquire();
+    if (!pmsg)
+      return -ENOBUFS;                 // pool exhausted (already reported)
+
+    BL_ms net = bl_net_ms();
+    uint8_t ttl = (pub && pub->ttl != BT_MESH_TTL_DEFAULT) ? pub->ttl
+                                                     : bt_mesh_default_ttl_get();
+
+    LOG(4,BL_G "pub: [VNDCLI:TIME %d ms], ttl: %d", (int)net, ttl);
+
+    bt_mesh_model_msg_init(&pmsg->nbs, BT_MESH_MODEL_OP_VND_TIME_BEACON);
+    net_buf_simple_add_le48(&pmsg->nbs, (uint64_t)net);
+    net_buf_simple_add_u8(&pmsg->nbs, ttl);
+
+    return bl_msg_publish(pmod, pmsg);
+  }
+
 //==============================================================================
 // GOOCLI publisher
 //==============================================================================
@@ -8,6 +8,9 @@
 #ifndef _PUBLISHER_H
 #define _PUBLISHER_H
 
+#include "bluccino.h"
+#include "bl_mesh.h"
+
 /* Others */
 #define LEVEL_S0   -32768
 #define LEVEL_S25  -16384
@@ -23,10 +26,38 @@
 
 void publish(struct k_work *work);
 
+//==============================================================================
+// publication buffer pool
+// - bl_msg_acquire() returns a free message buffer (NULL if pool exhausted)
+// - bl_msg_publish() sends buffer to model's publish address and releases
+//   the buffer as soon as the mesh stack has finished the transmission
+// - bl_msg_release() returns an unsent buffer to the pool
+//==============================================================================
+
+  BL_msg *bl_msg_acquire(void);
+  void bl_msg_release(BL_msg *pmsg);
+  int bl_msg_publish(BL_model *pmod, BL_msg *pmsg);
+  void bl_msg_stats(int *used, int *peak, int *fails);
+
 //==============================================================================
 // publisher interface
 //==============================================================================
 
   int bl_pub(BL_ob *o, int val);
 
+//==============================================================================
+// vendor bulk update: set on/off state of up to 32 elements in one message
+// - mask selects the elements (bit 0: element @ix 1), states the on/off values
+// - elements @1..@16 only and no network time: 16-bit encoding (fits one
+//   unsegmented PDU)
+//==============================================================================
+
+  int bl_pub_bulk(uint32_t mask, uint32_t states, BL_byte tt, BL_byte delay);
+
+//==============================================================================
+// vendor time beacon: publish network time (network time source only)
+//==============================================================================
+
+  int bl_pub_time(void);
+
 #endif
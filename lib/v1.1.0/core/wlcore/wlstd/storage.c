@@ -11,6 +11,7 @@
 //==============================================================================
 
   #include "ble_mesh.h"
+  #include "bl_boot.h"
   #include "bl_dcomp.h"
   #include "storage.h"
 
@@ -29,18 +30,44 @@
   #define LOGO(lvl,col,o,val)     LOGO_NVM(lvl,col WHO,o,val)
   #define LOG0(lvl,col,o,val)     LOGO_NVM(lvl,col,o,val)
 
+//==============================================================================
+// config defaults
+//==============================================================================
+
+  #ifndef CFG_NVM_QUIET_MS
+    #define CFG_NVM_QUIET_MS   500     // write-behind quiet period (ms)
+  #endif
+  #ifndef CFG_NVM_MAX_MS
+    #define CFG_NVM_MAX_MS    5000     // max write-behind delay (ms)
+  #endif
+
 //==============================================================================
 // locals
 //==============================================================================
 
-  static uint8_t storage_id;
   uint8_t reset_counter;
 
+    // write-behind queue: one pending bit per ps_variables_id; repeated
+    // save requests for the same item are coalesced until the quiet period
+    // has passed, then all pending items are written in one batch
+
+  static atomic_t pending = 0;         // bitmap of pending ps_variables_id's
+  static atomic_t writes = 0;          // number of actually written items
+  static atomic_t saved = 0;           // flash writes saved by coalescing
+  static int64_t since = 0;            // time stamp of oldest pending request
+  static struct k_spinlock nvm_lock;   // protects since (ISR callers)
+
     // the NVM cache
+    // - kept apart from bl_hwnvm's BL_nvc key cache: it is one "ps/nvm" item
+    //   of the "ps" settings subtree, restored by the same settings_load()
+    //   pass and written by the same write-behind queue as the other ps
+    //   items, and the wireless core must also work with hardware cores
+    //   that do not provide bl_hwnvm
 
   static int nvm_cache[20];            // our addressable NVM cache memory
   static bool dirty = false;           // is nvm_cache dirty?
   static bool ready = false;           // is nvm cache ready?
+  static bool loaded = false;          // nvm cache found by settings_load()?
 
 //==============================================================================
 // helper: settings init (initializes the zephyr settings subsystem)
@@ -142,12 +169,12 @@
   }
 
 //==============================================================================
-// callback: storage work handler
+// helper: write a single item to flash
 //==============================================================================
 
-  static void storage_work_handler(struct k_work *work)
+  static void save_item(uint8_t id)
   {
-  	switch (storage_id)
+  	switch (id)
     {
     	case NVM_CACHE:
     		save_nvm_cache();
@@ -179,17 +206,86 @@
   	}
   }
 
-  K_WORK_DEFINE(storage_work, storage_work_handler);
+//==============================================================================
+// callback: storage work handler (flush all pending items in one batch)
+//==============================================================================
+
+  static void storage_work_handler(struct k_work *work)
+  {
+    atomic_val_t bits = atomic_clear(&pending);
+
+    for (uint8_t id = 0; bits != 0; id++, bits >>= 1)
+    {
+      if (bits & 1)
+      {
+        save_item(id);
+        atomic_inc(&writes);
+      }
+    }
+
+    LOG(5,"flush: %d flash writes, %d flash writes saved",
+        (int)atomic_get(&writes), (int)atomic_get(&saved));
+  }
+
+  K_WORK_DELAYABLE_DEFINE(storage_work, storage_work_handler);
+
+//==============================================================================
+// helper: flush all pending items immediately
+//==============================================================================
+
+  static void flush_on_flash(void)
+  {
+  	k_work_reschedule(&storage_work, K_NO_WAIT);
+  }
 
 //==============================================================================
 // helper: save on flash
+// - marks item as pending and (re)starts the quiet period timer, so a
+//   burst of saves ends up in one batched flush
+// - the quiet period is not extended any more once the oldest pending
+//   request is older than CFG_NVM_MAX_MS (nodes which toggle continuously)
+// - RESET_COUNTER bypasses the write-behind: multireset counts power cycles,
+//   so each increment must reach flash before power may be cut again
+// - may be called in ISR context (timer callbacks), since is lock protected
 //==============================================================================
 
   void save_on_flash(uint8_t id)
   {
-  	storage_id = id;
     LOG(5,"save_on_flash: @%d",id);
-  	k_work_submit(&storage_work);
+
+    if (id == RESET_COUNTER)
+    {
+      atomic_or(&pending, BIT(id));
+      flush_on_flash();                // write immediately (with pendings)
+      return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&nvm_lock);
+
+    int64_t now = k_uptime_get();
+    atomic_val_t old = atomic_or(&pending, BIT(id));
+
+    if (old == 0)
+      since = now;                     // first pending request
+    else if (old & BIT(id))
+      atomic_inc(&saved);              // coalesced with a pending write
+
+    bool extend = (now - since < CFG_NVM_MAX_MS);
+    k_spin_unlock(&nvm_lock,key);
+
+    if (extend)
+  	  k_work_reschedule(&storage_work, K_MSEC(CFG_NVM_QUIET_MS));
+    else
+  	  k_work_schedule(&storage_work, K_MSEC(CFG_NVM_QUIET_MS));
+  }
+
+//==============================================================================
+// helper: number of flash writes saved by coalescing
+//==============================================================================
+
+  int storage_writes_saved(void)
+  {
+    return (int)atomic_get(&saved);
   }
 
 //==============================================================================
@@ -198,7 +294,11 @@
 
   static void nvm_ready_worker(struct k_work *work)
   {
+    if (ready)
+      return;                          // already notified
+
 		ready = true;
+    bl_boot(BOOT_NVM_READY);
     LOG(4,BL_M "NVM is now ready");
     _bl_msg((bl_storage),_NVM,READY_, 0,NULL,ready);  // (BL_NVM) <- [NVM:READY ready]
   }
@@ -229,7 +329,7 @@
       if (!strncmp(key, "nvm", key_len))
       {
         len = read_cb(cb_arg, &nvm_cache, sizeof(nvm_cache));
-        submit_nvm_ready();
+        loaded = (len == sizeof(nvm_cache));
       }
 
       if (!strncmp(key, "rc", key_len))
@@ -280,6 +380,40 @@
     return -ENOENT;
   }
 
+//==============================================================================
+// helper: settings_load() has completed (commit phase)
+// - if no (valid) NVM cache has been loaded we start with a zeroed cache,
+//   which is marked dirty to get it backed up with the next tock
+// - either way NVM readiness is notified right here (event instead of timeout)
+//==============================================================================
+
+  static int ps_commit(void)
+  {
+    if (!loaded)
+    {
+      LOG(4,BL_R "reset NVM cache (no NVM cache loaded)");
+
+      for (int i=0; i<BL_LEN(nvm_cache); i++)
+        nvm_cache[i] = 0;              // init NVM cache
+
+      dirty = true;
+    }
+
+    submit_nvm_ready();                // notify higher levels
+    return 0;
+  }
+
+//==============================================================================
+// helper: make NVM ready if settings_load() is never going to run (settings
+// disabled, or Bluetooth/mesh init failed before settings could be loaded)
+//==============================================================================
+
+  void storage_fallback(void)
+  {
+    if (!ready)
+      ps_commit();                     // start with zeroed cache if not loaded
+  }
+
 //==============================================================================
 // settings handler
 //==============================================================================
@@ -288,6 +422,7 @@
          {
   	       .name = "ps",
   	       .h_set = ps_set,
+  	       .h_commit = ps_commit,
          };
 
 //==============================================================================
@@ -305,13 +440,31 @@
   {
     if (o->data == NULL)
     {
-      save_nvm_cache();
+      save_on_flash(NVM_CACHE);        // queue NVM cache ...
+      flush_on_flash();                // and flush without quiet period
+      dirty = false;
       return 0;                        // OK
     }
 
     return -1;                         // otherwise return error
   }
 
+//==============================================================================
+// worker: flush NVM cache and all pending items (e.g. before power down)
+//==============================================================================
+
+  static int nvm_flush(BL_ob *o, int val)
+  {
+    if (ready && dirty)
+    {
+      save_on_flash(NVM_CACHE);
+      dirty = false;
+    }
+
+    flush_on_flash();                  // write pending items without delay
+    return 0;                          // OK
+  }
+
 //==============================================================================
 // worker: store value in NVM
 //==============================================================================
@@ -355,23 +508,10 @@
   {
     if (val % 2 == 0)                  // every 2 seconds
     {
-      if (!ready && val >= 4)          // if not ready in 4 seconds
-      {
-        LOG(4,BL_R "reset NVM cache (since wasn't ready within 4s)");
-
-        for (int i=0; i<BL_LEN(nvm_cache); i++)
-          nvm_cache[i] = 0;            // init NVM cache
-
-        ready = true;
-        dirty = true;
-
-        submit_nvm_ready();            // notify higher levels
-      }
-
       if (ready && dirty)
       {
         LOG(4,"backup NVM cache ...");
-        save_nvm_cache();
+        save_on_flash(NVM_CACHE);      // write-behind (coalesced)
         dirty = false;
       }
     }
@@ -419,6 +559,7 @@
 // (W)->    STORE ->|      @ix,val       | store value in NVM at location @ix
 // (W)->   RECALL ->|        @ix         | recall value in NVM at location @ix
 // (W)->     SAVE ->|                    | save NVM cache to NVM
+// (W)->    FLUSH ->|                    | flush pending NVM writes
 //                  |....................|
 //                  |        NVM:        | NVM output interface
 // (W)<-    READY <-|       ready        | notification that NVM is now ready
@@ -448,6 +589,9 @@
       case BL_ID(_NVM,SAVE_):        // [NVM:STORE @ix,val]
         return nvm_save(o,val);      // delegate to nvm_save() worker
 
+      case NVM_FLUSH_0_0_0:          // [NVM:FLUSH]
+        return nvm_flush(o,val);     // delegate to nvm_flush() worker
+
       case _BL_ID(_NVM,READY_):      // [#NVM:READY]
         return bl_out(o,val,(W));    // [NVM:READY] -> (W)
 
@@ -31,6 +31,8 @@ extern uint8_t reset_counter;
 
 //int ps_settings_init(void);
 void save_on_flash(uint8_t id);
+void storage_fallback(void);           // NVM ready without settings_load()
+int storage_writes_saved(void);        // flash writes saved by coalescing
 
 //==============================================================================
 // public module interface
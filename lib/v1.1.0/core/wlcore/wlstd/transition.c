@@ -12,6 +12,7 @@
 #include "bl_dcomp.h"
 #include "state_binding.h"
 #include "transition.h"
+#include "bl_trans.h"
 
 struct transition transition;
 
@@ -87,7 +88,7 @@ static bool set_transition_counter(struct transition *transition)
 		break;
 	}
 
-	transition->counter = ((float) transition->total_duration / 100);
+	transition->counter = transition->total_duration / 100U;
 
 	if (transition->counter > DEVICE_SPECIFIC_RESOLUTION) {
 		transition->counter = DEVICE_SPECIFIC_RESOLUTION;
@@ -107,78 +108,125 @@ void set_transition_values(uint8_t type)
 		return;
 	}
 
+	/* per step increments are computed in Q.8 by slot_load() */
+
 	ctl->transition->quo_tt = ctl->transition->total_duration /
 				  ctl->transition->counter;
+}
+
+/* Transition scheduler (Start)
+ *
+ * The running transition (there is only the one of ctl) is kept in a single
+ * slot which is served by a one-shot kernel timer and a work item. The timer
+ * is armed for the next step; the work handler then advances the slot (using
+ * fixed-point increments) and emits one light state update per step.
+ */
+
+#define FIXED_SHIFT		8	/* Q.8 fixed-point accumulators */
+
+enum transition_channel {
+	CHAN_LIGHT = 0x01,
+	CHAN_TEMP = 0x02,
+	CHAN_DUV = 0x04,
+};
+
+struct transition_slot {
+	struct transition *transition;
+	uint8_t type;
+	uint8_t channels;
+	int64_t due;
+
+	int32_t light, light_step;
+	int32_t temp, temp_step;
+	int32_t duv, duv_step;
+};
+
+static struct transition_slot slot;
+static bool active;
+
+static struct k_spinlock slot_lock;
 
+static void transition_work_handler(struct k_work *work);
+static void transition_timer_handler(struct k_timer *timer);
+
+K_WORK_DEFINE(transition_work, transition_work_handler);
+K_TIMER_DEFINE(transition_timer, transition_timer_handler, NULL);
+
+static uint8_t transition_channels(uint8_t type)
+{
 	switch (type) {
 	case ONOFF:
 	case LEVEL_LIGHT:
 	case ACTUAL:
 	case LINEAR:
-		ctl->light->delta =
-			((float) (ctl->light->current - ctl->light->target) /
-			 ctl->transition->counter);
-		break;
-	case CTL_LIGHT:
-		ctl->light->delta =
-			((float) (ctl->light->current - ctl->light->target) /
-			 ctl->transition->counter);
-
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
-
-		ctl->duv->delta =
-			((float) (ctl->duv->current - ctl->duv->target) /
-			 ctl->transition->counter);
-		break;
+		return CHAN_LIGHT;
 	case LEVEL_TEMP:
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
-		break;
+		return CHAN_TEMP;
+	case CTL_LIGHT:
+		return CHAN_LIGHT | CHAN_TEMP | CHAN_DUV;
 	case CTL_TEMP:
-		ctl->temp->delta =
-			((float) (ctl->temp->current - ctl->temp->target) /
-			 ctl->transition->counter);
-
-		ctl->duv->delta =
-			((float) (ctl->duv->current - ctl->duv->target) /
-			 ctl->transition->counter);
-		break;
+		return CHAN_TEMP | CHAN_DUV;
 	default:
-		return;
+		return 0;
 	}
 }
 
-/* Timers related handlers & threads (Start) */
-static void onoff_work_handler(struct k_work *work)
+static int32_t fixed_step(int32_t current, int32_t target, uint32_t counter)
 {
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
+	return ((target - current) * (1 << FIXED_SHIFT)) / (int32_t) counter;
+}
 
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
+static void slot_load(struct transition_slot *slot)
+{
+	uint32_t counter = slot->transition->counter ?
+			   slot->transition->counter : 1U;
+
+	slot->light = (int32_t) ctl->light->current << FIXED_SHIFT;
+	slot->temp = (int32_t) ctl->temp->current << FIXED_SHIFT;
+	slot->duv = (int32_t) ctl->duv->current * (1 << FIXED_SHIFT);
+
+	slot->light_step = fixed_step(ctl->light->current,
+				      ctl->light->target, counter);
+	slot->temp_step = fixed_step(ctl->temp->current,
+				     ctl->temp->target, counter);
+	slot->duv_step = fixed_step(ctl->duv->current,
+				    ctl->duv->target, counter);
+}
 
-		return;
+static void slot_advance(struct transition_slot *slot)
+{
+	if (slot->channels & CHAN_LIGHT) {
+		slot->light += slot->light_step;
+		ctl->light->current = slot->light >> FIXED_SHIFT;
 	}
 
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
+	if (slot->channels & CHAN_TEMP) {
+		slot->temp += slot->temp_step;
+		ctl->temp->current = slot->temp >> FIXED_SHIFT;
+	}
+
+	if (slot->channels & CHAN_DUV) {
+		slot->duv += slot->duv_step;
+		ctl->duv->current = slot->duv / (1 << FIXED_SHIFT);
+	}
+}
+
+static void slot_finish(struct transition_slot *slot)
+{
+	if (slot->channels & CHAN_LIGHT) {
 		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
+	}
+
+	if (slot->channels & CHAN_TEMP) {
+		ctl->temp->current = ctl->temp->target;
+	}
+
+	if (slot->channels & CHAN_DUV) {
+		ctl->duv->current = ctl->duv->target;
 	}
 }
 
-static void level_move_lightness_work_handler(void)
+static void level_move_lightness_step(struct transition *transition)
 {
 	int light;
 
@@ -201,46 +249,13 @@ static void level_move_lightness_work_handler(void)
 	}
 
 	ctl->light->current = light;
-	update_light_state();
 
 	if (ctl->light->target == light) {
-		ctl->transition->counter = 0;
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
-
-static void level_lightness_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
-
-		return;
-	}
-
-	if (ctl->transition->type == MOVE) {
-		level_move_lightness_work_handler();
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
+		transition->counter = 0;
 	}
 }
 
-static void level_move_temp_work_handler(void)
+static void level_move_temp_step(struct transition *transition)
 {
 	int temp;
 
@@ -263,309 +278,183 @@ static void level_move_temp_work_handler(void)
 	}
 
 	ctl->temp->current = temp;
-	update_light_state();
 
 	if (ctl->temp->target == temp) {
-		ctl->transition->counter = 0;
-		k_timer_stop(&ctl->transition->timer);
+		transition->counter = 0;
 	}
 }
 
-static void level_temp_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
+/* advance the due slot, return false if the slot has completed */
 
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
+static bool slot_step(struct transition_slot *slot, int64_t now)
+{
+	struct transition *transition = slot->transition;
 
-		return;
-	}
+	if (transition->just_started) {
+		transition->just_started = false;
 
-	if (ctl->transition->type == MOVE) {
-		level_move_temp_work_handler();
-		return;
-	}
+		if (transition->counter == 0U) {
+			return false;
+		}
 
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->temp->current -= ctl->temp->delta;
-		update_light_state();
-	} else {
-		ctl->temp->current = ctl->temp->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
+		transition->start_timestamp = now;
+		slot->due += transition->quo_tt;
+		return true;
 	}
-}
 
-static void light_lightness_actual_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
+	slot->due += transition->quo_tt;
 
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
+	if (transition->type == MOVE) {
+		if (slot->type == LEVEL_TEMP) {
+			level_move_temp_step(transition);
 		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+			level_move_lightness_step(transition);
 		}
 
-		return;
+		return transition->counter != 0U;
 	}
 
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
+	transition->counter--;
+	if (transition->counter) {
+		slot_advance(slot);
+		return true;
 	}
+
+	slot_finish(slot);
+	return false;
 }
 
-static void light_lightness_linear_work_handler(struct k_work *work)
+static void transition_arm(int64_t now)
 {
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
-
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		ctl->light->current -= ctl->light->delta;
-		update_light_state();
+	if (!active) {
+		k_timer_stop(&transition_timer);
 	} else {
-		ctl->light->current = ctl->light->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
+		k_timer_start(&transition_timer,
+			      K_MSEC(slot.due > now ? slot.due - now : 0),
+			      K_NO_WAIT);
 	}
 }
 
-static void light_ctl_work_handler(struct k_work *work)
+static void transition_work_handler(struct k_work *work)
 {
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
+	int64_t now = k_uptime_get();
+	bool changed = false;
+	k_spinlock_key_t key;
 
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
-		}
-
-		return;
-	}
-
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		/* Lightness */
-		ctl->light->current -= ctl->light->delta;
-		/* Temperature */
-		ctl->temp->current -= ctl->temp->delta;
-		/* Delta_UV */
-		ctl->duv->current -= ctl->duv->delta;
-		update_light_state();
-	} else {
-		ctl->light->current = ctl->light->target;
-		ctl->temp->current = ctl->temp->target;
-		ctl->duv->current = ctl->duv->target;
-		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
-	}
-}
+	key = k_spin_lock(&slot_lock);
 
-static void light_ctl_temp_work_handler(struct k_work *work)
-{
-	if (ctl->transition->just_started) {
-		ctl->transition->just_started = false;
+	if (active && slot.due <= now) {
+		changed = true;
 
-		if (ctl->transition->counter == 0U) {
-			update_light_state();
-			k_timer_stop(&ctl->transition->timer);
-		} else {
-			ctl->transition->start_timestamp = k_uptime_get();
+		if (!slot_step(&slot, now)) {
+			slot.transition->counter = 0U;
+			active = false;
 		}
-
-		return;
 	}
 
-	ctl->transition->counter--;
-	if (ctl->transition->counter) {
-		/* Temperature */
-		ctl->temp->current -= ctl->temp->delta;
-		/* Delta_UV */
-		ctl->duv->current -= ctl->duv->delta;
-		update_light_state();
-	} else {
-		ctl->temp->current = ctl->temp->target;
-		ctl->duv->current = ctl->duv->target;
+	transition_arm(now);
+	k_spin_unlock(&slot_lock, key);
+
+	if (changed) {
 		update_light_state();
-		k_timer_stop(&ctl->transition->timer);
 	}
 }
 
-
-K_WORK_DEFINE(onoff_work, onoff_work_handler);
-K_WORK_DEFINE(level_lightness_work, level_lightness_work_handler);
-K_WORK_DEFINE(level_temp_work, level_temp_work_handler);
-K_WORK_DEFINE(light_lightness_actual_work, light_lightness_actual_work_handler);
-K_WORK_DEFINE(light_lightness_linear_work, light_lightness_linear_work_handler);
-K_WORK_DEFINE(light_ctl_work, light_ctl_work_handler);
-K_WORK_DEFINE(light_ctl_temp_work, light_ctl_temp_work_handler);
-
-static void onoff_tt_handler(struct k_timer *dummy)
+static void transition_timer_handler(struct k_timer *timer)
 {
-	k_work_submit(&onoff_work);
+	k_work_submit(&transition_work);
 }
 
-static void level_lightness_tt_handler(struct k_timer *dummy)
+void transition_stop(struct transition *transition)
 {
-	k_work_submit(&level_lightness_work);
-}
+	k_spinlock_key_t key;
 
-static void level_temp_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&level_temp_work);
-}
+	status_invalidate();
+	key = k_spin_lock(&slot_lock);
 
-static void light_lightness_actual_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_lightness_actual_work);
-}
+	if (active && slot.transition == transition) {
+		active = false;
+		transition_arm(k_uptime_get());
+	}
 
-static void light_lightness_linear_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_lightness_linear_work);
+	k_spin_unlock(&slot_lock, key);
 }
 
-static void light_ctl_tt_handler(struct k_timer *dummy)
+void transition_start(struct transition *transition, uint8_t type)
 {
-	k_work_submit(&light_ctl_work);
-}
+	k_spinlock_key_t key;
+	int64_t now, begin;
+
+	status_invalidate();
+
+	/* synced nodes begin on the network time grid (CFG_NETTIME_SLOT_MS), so
+	 * that all servers reached by the same message start at the same time
+	 */
+	now = k_uptime_get();
+	if (transition->at) {
+		begin = MAX(now, bl_net2ms(transition->at));
+		transition->at = 0;	/* consumed */
+	} else {
+		begin = bl_net_align(now + transition->delay * 5U);
+	}
 
-static void light_ctl_temp_tt_handler(struct k_timer *dummy)
-{
-	k_work_submit(&light_ctl_temp_work);
+	if (transition->counter == 0U && begin == now) {
+		update_light_state();
+		return;
+	}
+
+	key = k_spin_lock(&slot_lock);
+
+	slot.transition = transition;	/* (re)starts the running transition */
+	slot.type = type;
+	slot.channels = transition_channels(type);
+	slot.due = begin;
+	slot_load(&slot);
+	active = true;
+
+	transition_arm(now);
+	k_spin_unlock(&slot_lock, key);
 }
-/* Timers related handlers & threads (End) */
+/* Transition scheduler (End) */
 
 K_TIMER_DEFINE(dummy_timer, NULL, NULL);
 
 /* Messages handlers (Start) */
 void onoff_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer, onoff_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, ONOFF);
 }
 
 void level_lightness_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     level_lightness_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, LEVEL_LIGHT);
 }
 
 void level_temp_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer, level_temp_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, LEVEL_TEMP);
 }
 
 void light_lightness_actual_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_lightness_actual_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, ACTUAL);
 }
 
 void light_lightness_linear_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_lightness_linear_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, LINEAR);
 }
 
 void light_ctl_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer, light_ctl_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, CTL_LIGHT);
 }
 
 void light_ctl_temp_handler(void)
 {
-	if (ctl->transition->counter == 0U && ctl->transition->delay == 0) {
-		update_light_state();
-		return;
-	}
-
-	k_timer_init(&ctl->transition->timer,
-		     light_ctl_temp_tt_handler, NULL);
-
-	k_timer_start(&ctl->transition->timer,
-		      K_MSEC(ctl->transition->delay * 5U),
-		      K_MSEC(ctl->transition->quo_tt));
+	transition_start(ctl->transition, CTL_TEMP);
 }
+/* Messages handlers (End) */
 
 //==============================================================================
 // cleanup (needed for *.c file merge of the bluccino core)
@@ -28,8 +28,7 @@ struct transition {
 	uint32_t counter;
 	uint32_t total_duration;
 	int64_t start_timestamp;
-
-	struct k_timer timer;
+	int64_t at;		/* network start time (0: start after delay) */
 };
 
 extern struct transition transition;
@@ -39,6 +38,9 @@ extern struct k_timer dummy_timer;
 void calculate_rt(struct transition *transition);
 void set_transition_values(uint8_t type);
 
+void transition_start(struct transition *transition, uint8_t type);
+void transition_stop(struct transition *transition);
+
 void onoff_handler(void);
 void level_lightness_handler(void);
 void level_temp_handler(void);
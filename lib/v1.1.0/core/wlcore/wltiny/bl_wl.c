@@ -21,6 +21,8 @@
   #include "bl_hw.h"                   // hardware core
   #include "bl_wl.h"                   // wireless core
 
+  #include "bl_dejavu.c"               // shared de-ja-vu cache
+
   #define PMI  bl_wl                   // public module interface
 
 //==============================================================================
@@ -33,6 +35,46 @@
   #define LOGO(lvl,col,o,val)     LOGO_CORE(lvl,col WHO,o,val)
   #define LOG0(lvl,col,o,val)     LOGO_CORE(lvl,col,o,val)
 
+//==============================================================================
+// low power node (LPN) profile
+// - CFG_LPN: enable friendship polling after provisioning, batch GOOCLI
+//   publications into CFG_LPN_BATCH_MS windows, log a power/duty report
+//   every CFG_LPN_REPORT tocks
+// - the power report is simulated from radio event counts and the figures
+//   below (defaults: nRF52 class radio, CR2032 coin cell)
+//==============================================================================
+
+#ifndef CFG_LPN
+  #ifdef CONFIG_BT_MESH_LOW_POWER
+    #define CFG_LPN             1      // LPN profile follows Kconfig
+  #else
+    #define CFG_LPN             0      // always-on (relay capable) node
+  #endif
+#endif
+
+#if (CFG_LPN && !defined(CONFIG_BT_MESH_LOW_POWER))
+  #error CFG_LPN                       // requires CONFIG_BT_MESH_LOW_POWER=y
+#endif
+
+#ifndef CFG_LPN_BATCH_MS
+  #define CFG_LPN_BATCH_MS     50      // publish window for batching (ms)
+#endif
+#ifndef CFG_LPN_REPORT
+  #define CFG_LPN_REPORT       60      // power report period (tocks)
+#endif
+#ifndef CFG_LPN_TX_US
+  #define CFG_LPN_TX_US      1200      // radio time per advertising TX (us)
+#endif
+#ifndef CFG_LPN_RADIO_UA
+  #define CFG_LPN_RADIO_UA   6000      // radio current while on (uA)
+#endif
+#ifndef CFG_LPN_SLEEP_UA
+  #define CFG_LPN_SLEEP_UA      3      // system ON sleep current (uA)
+#endif
+#ifndef CFG_LPN_BATTERY_MAH
+  #define CFG_LPN_BATTERY_MAH 230      // battery capacity (mAh)
+#endif
+
 //==============================================================================
 // let's go ...
 //==============================================================================
@@ -43,6 +85,13 @@
 #define BT_MESH_MODEL_OP_GEN_ONOFF_SET_UNACK	BT_MESH_MODEL_OP_2(0x82, 0x03)
 #define BT_MESH_MODEL_OP_GEN_ONOFF_STATUS	BT_MESH_MODEL_OP_2(0x82, 0x04)
 
+/* Vendor bulk on/off update (same vendor model as the standard core):
+ * mask, states (both le16 or le32), TID, [TT, delay [, network start time]]
+ */
+#define CID_ZEPHYR				0x0002
+#define VND_MODEL_ID				0x4321
+#define BT_MESH_MODEL_OP_VND_BULK_SET_UNACK	BT_MESH_MODEL_OP_3(0x05, CID_ZEPHYR)
+
 static int gen_onoff_set(struct bt_mesh_model *model,
 			 struct bt_mesh_msg_ctx *ctx,
 			 struct net_buf_simple *buf);
@@ -59,6 +108,10 @@ static int gen_onoff_status(struct bt_mesh_model *model,
 			    struct bt_mesh_msg_ctx *ctx,
 			    struct net_buf_simple *buf);
 
+static int vnd_bulk_set_unack(struct bt_mesh_model *model,
+			      struct bt_mesh_msg_ctx *ctx,
+			      struct net_buf_simple *buf);
+
 /*
  * Client Configuration Declaration
  */
@@ -73,6 +126,37 @@ static struct bt_mesh_cfg_cli cfg_cli = {
 static struct bt_mesh_health_srv health_srv = {
 };
 
+BT_MESH_HEALTH_PUB_DEFINE(health_pub, 0);
+
+//==============================================================================
+// element table
+// - element count and per element model set are generated at compile time
+// - every element hosts a generic on/off server and a generic on/off client
+// - CFG_WL_ELEMENTS must be a plain integer literal (used by LISTIFY)
+//==============================================================================
+
+#ifndef CFG_WL_ELEMENTS
+  #define CFG_WL_ELEMENTS   4          // number of on/off elements (channels)
+#endif
+
+#if (CFG_WL_ELEMENTS < 2)
+  #error CFG_WL_ELEMENTS                 // must be at least 2
+#endif
+
+  #define GOO_SRV  0                   // model slot of generic on/off server
+  #define GOO_CLI  1                   // model slot of generic on/off client
+  #define GOO_PUBLEN  (2 + 2)          // publication size: opcode + content
+
+//==============================================================================
+// per element state (struct of arrays, indexed by element index)
+//==============================================================================
+
+  static struct
+         {
+           uint8_t current[CFG_WL_ELEMENTS];   // current on/off state
+           uint8_t previous[CFG_WL_ELEMENTS];  // previous on/off state
+         } state;
+
 /*
  * Publication Declarations
  *
@@ -88,18 +172,28 @@ static struct bt_mesh_health_srv health_srv = {
  * because it is added to a stack variable at the time a
  * transmission occurs.
  *
+ * Publication buffers are tied to their publication contexts by
+ * pub_init() before the mesh stack is initialized.
  */
 
-BT_MESH_HEALTH_PUB_DEFINE(health_pub, 0);
+  static struct bt_mesh_model_pub goo_pub[CFG_WL_ELEMENTS][2];
+  static struct net_buf_simple goo_pub_msg[CFG_WL_ELEMENTS][2];
+  static uint8_t goo_pub_data[CFG_WL_ELEMENTS][2][GOO_PUBLEN];
 
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_srv, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_cli, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_srv_s_0, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_cli_s_0, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_srv_s_1, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_cli_s_1, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_srv_s_2, NULL, 2 + 2);
-BT_MESH_MODEL_PUB_DEFINE(gen_onoff_pub_cli_s_2, NULL, 2 + 2);
+  static void pub_init(void)
+  {
+    for (int e=0; e < CFG_WL_ELEMENTS; e++)
+      for (int k=0; k < 2; k++)
+      {
+        struct net_buf_simple *msg = &goo_pub_msg[e][k];
+
+        msg->data = goo_pub_data[e][k];
+        msg->len = 0;
+        msg->size = GOO_PUBLEN;
+        msg->__buf = goo_pub_data[e][k];
+        goo_pub[e][k].msg = msg;
+      }
+  }
 
 /*
  * Models in an element must have unique op codes.
@@ -131,107 +225,77 @@ static const struct bt_mesh_model_op gen_onoff_cli_op[] = {
 	BT_MESH_MODEL_OP_END,
 };
 
-struct onoff_state {
-  int id;
-	uint8_t current;
-	uint8_t previous;
-	uint8_t led_gpio_pin;
-	const struct device *led_device;
-};
-
 /*
- * Declare and Initialize Element Contexts
- * Change to select different GPIO output pins
+ * Vendor Model Op Dispatch Table
  */
 
-static struct onoff_state onoff_state[] = {
-	{ .id=1, .led_gpio_pin = DT_GPIO_PIN(DT_ALIAS(led0), gpios) },
-	{ .id=2, .led_gpio_pin = DT_GPIO_PIN(DT_ALIAS(led1), gpios) },
-	{ .id=3, .led_gpio_pin = DT_GPIO_PIN(DT_ALIAS(led2), gpios) },
-	{ .id=4, .led_gpio_pin = DT_GPIO_PIN(DT_ALIAS(led3), gpios) },
+static const struct bt_mesh_model_op vnd_op[] = {
+	{ BT_MESH_MODEL_OP_VND_BULK_SET_UNACK, BT_MESH_LEN_MIN(5), vnd_bulk_set_unack },
+	BT_MESH_MODEL_OP_END,
 };
 
 /*
- *
- * Element Model Declarations
- *
- * Element 0 Root Models
+ * Element Model Declarations (generated from the element table)
  */
 
-static struct bt_mesh_model root_models[] = {
-	BT_MESH_MODEL_CFG_SRV,
-	BT_MESH_MODEL_CFG_CLI(&cfg_cli),
-	BT_MESH_MODEL_HEALTH_SRV(&health_srv, &health_pub),
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_SRV, gen_onoff_srv_op,
-		      &gen_onoff_pub_srv, &onoff_state[0]),
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_CLI, gen_onoff_cli_op,
-		      &gen_onoff_pub_cli, &onoff_state[0]),
-};
+  #define GOO_MODELS(e)                                                      \
+          BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_SRV, gen_onoff_srv_op,    \
+                        &goo_pub[e][GOO_SRV], NULL),                         \
+          BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_CLI, gen_onoff_cli_op,    \
+                        &goo_pub[e][GOO_CLI], NULL)
 
-/*
- * Element 1 Models
- */
+  #define SECONDARY_MODELS(i,_)  { GOO_MODELS((i)+1) }
+  #define SECONDARY_ELEM(i,_)    BT_MESH_ELEM(0, secondary_models[i],        \
+                                              BT_MESH_MODEL_NONE)
 
-static struct bt_mesh_model secondary_0_models[] = {
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_SRV, gen_onoff_srv_op,
-		      &gen_onoff_pub_srv_s_0, &onoff_state[1]),
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_CLI, gen_onoff_cli_op,
-		      &gen_onoff_pub_cli_s_0, &onoff_state[1]),
-};
+  #define ROOT_GOO  3                  // index of first on/off model in root
 
 /*
- * Element 2 Models
+ * Element 0 Root Models
  */
 
-static struct bt_mesh_model secondary_1_models[] = {
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_SRV, gen_onoff_srv_op,
-		      &gen_onoff_pub_srv_s_1, &onoff_state[2]),
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_CLI, gen_onoff_cli_op,
-		      &gen_onoff_pub_cli_s_1, &onoff_state[2]),
+static struct bt_mesh_model root_models[] = {
+	BT_MESH_MODEL_CFG_SRV,
+	BT_MESH_MODEL_CFG_CLI(&cfg_cli),
+	BT_MESH_MODEL_HEALTH_SRV(&health_srv, &health_pub),
+	GOO_MODELS(0),
 };
 
 /*
- * Element 3 Models
+ * Element 0 Vendor Models
  */
 
-static struct bt_mesh_model secondary_2_models[] = {
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_SRV, gen_onoff_srv_op,
-		      &gen_onoff_pub_srv_s_2, &onoff_state[3]),
-	BT_MESH_MODEL(BT_MESH_MODEL_ID_GEN_ONOFF_CLI, gen_onoff_cli_op,
-		      &gen_onoff_pub_cli_s_2, &onoff_state[3]),
+static struct bt_mesh_model vnd_models[] = {
+	BT_MESH_MODEL_VND(CID_ZEPHYR, VND_MODEL_ID, vnd_op, NULL, NULL),
 };
 
 /*
- * Button to Client Model Assignments
+ * Element 1 ... CFG_WL_ELEMENTS-1 Models
  */
 
-struct bt_mesh_model *mod_cli_sw[] = {
-		&root_models[4],
-		&secondary_0_models[1],
-		&secondary_1_models[1],
-		&secondary_2_models[1],
-};
+  static struct bt_mesh_model secondary_models[CFG_WL_ELEMENTS-1][2] =
+  {
+    LISTIFY(UTIL_DEC(CFG_WL_ELEMENTS), SECONDARY_MODELS, (,))
+  };
 
-/*
- * LED to Server Model Assigmnents
- */
+//==============================================================================
+// model lookup: O(1) access to on/off server/client model of element e
+//==============================================================================
 
-struct bt_mesh_model *mod_srv_sw[] = {
-		&root_models[3],
-		&secondary_0_models[0],
-		&secondary_1_models[0],
-		&secondary_2_models[0],
-};
+  static struct bt_mesh_model *goo_model(int e, int slot)
+  {
+    if (e == 0)
+      return &root_models[ROOT_GOO + slot];
+    return &secondary_models[e-1][slot];
+  }
 
 //==============================================================================
 // Root and Secondary Element Declarations
 //==============================================================================
 
 	static struct bt_mesh_elem elements[] = {
-		BT_MESH_ELEM(0, root_models, BT_MESH_MODEL_NONE),
-		BT_MESH_ELEM(0, secondary_0_models, BT_MESH_MODEL_NONE),
-		BT_MESH_ELEM(0, secondary_1_models, BT_MESH_MODEL_NONE),
-		BT_MESH_ELEM(0, secondary_2_models, BT_MESH_MODEL_NONE),
+		BT_MESH_ELEM(0, root_models, vnd_models),
+		LISTIFY(UTIL_DEC(CFG_WL_ELEMENTS), SECONDARY_ELEM, (,))
 	};
 
 	static const struct bt_mesh_comp comp = {
@@ -258,13 +322,13 @@ struct bt_mesh_model *mod_srv_sw[] = {
 				 struct net_buf_simple *buf)
 	{
 		NET_BUF_SIMPLE_DEFINE(msg, 2 + 1 + 4);
-		struct onoff_state *onoff_state = model->user_data;
+		uint8_t current = state.current[model->elem_idx];
 
 	  LOG(5,BL_Y "addr 0x%04x onoff 0x%02x",
-		      bt_mesh_model_elem(model)->addr, onoff_state->current);
+		      bt_mesh_model_elem(model)->addr, current);
 
 		bt_mesh_model_msg_init(&msg, BT_MESH_MODEL_OP_GEN_ONOFF_STATUS);
-		net_buf_simple_add_u8(&msg, onoff_state->current);
+		net_buf_simple_add_u8(&msg, current);
 
 		if (bt_mesh_model_send(model, ctx, &msg, NULL, NULL)) {
 			printk("Unable to send On Off Status response\n");
@@ -277,25 +341,24 @@ struct bt_mesh_model *mod_srv_sw[] = {
 // notify app level about receive of GOOSET or GOO LET
 //==============================================================================
 
-  static int goo_notify(struct onoff_state *p, bool acked)
+  static int goo_notify(int idx, bool acked)
   {
-    static BL_goo goo[4];              // 4 generic on/off servers
+    static BL_goo goo[CFG_WL_ELEMENTS];// one per generic on/off server
 
     BL_ms now = bl_ms();
 
       // do we have a static BL_goo structure?
 
-    int idx = p->id - 1;
     if (idx < 0 || idx >= BL_LEN(goo))
       return bl_err(-1,"goo_notify: model @ix out of range");
 
         // fill BL_goo structure
 
     BL_goo *g = goo + idx;
-    g->trans.basis = p->previous;
+    g->trans.basis = state.previous[idx];
     g->delay = 0;
     g->trans.tt = 0;
-    g->trans.target = p->current;
+    g->trans.target = state.current[idx];
     g->trans.begin = now;
     g->remain = 0;
     g->tid = 0;                        // don't care about TID
@@ -303,7 +366,7 @@ struct bt_mesh_model *mod_srv_sw[] = {
 
       // submit message
 
-    return _bl_post((PMI), _GOOSRV_STS_ix_BL_goo_sts, p->id,goo+idx,p->current);
+    return _bl_post((PMI), _GOOSRV_STS_ix_BL_goo_sts, idx+1,g,g->trans.target);
   }
 
 //==============================================================================
@@ -315,14 +378,16 @@ static int gen_onoff_let_or_set(struct bt_mesh_model *model,
 			       struct net_buf_simple *buf, bool acked)
 {
 	struct net_buf_simple *msg = model->pub->msg;
-	struct onoff_state *p = model->user_data;                           //@@@4.8
+	int idx = model->elem_idx;          // O(1) access to element state
+	uint8_t *current = &state.current[idx];
+	uint8_t *previous = &state.previous[idx];
 	int err;
 
-	p->current = net_buf_simple_pull_u8(buf);                           //@@@4.8
+	*current = net_buf_simple_pull_u8(buf);                             //@@@4.8
 /*
 	if (bl_dbg(4))
   	printk(BL_G"addr 0x%02x state 0x%02x\n"BL_0,
-	       bt_mesh_model_elem(model)->addr, p->current);                //@@@4.8
+	       bt_mesh_model_elem(model)->addr, *current);                  //@@@4.8
 */
 
 //>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -343,14 +408,14 @@ static int gen_onoff_let_or_set(struct bt_mesh_model *model,
 
   bool provision = (model->pub->addr != BT_MESH_ADDR_UNASSIGNED);
 
-	if (p->previous != p->current && provision)                         //@@@4.8
+	if (*previous != *current && provision)                             //@@@4.8
 	{
-		BL_LOG(5,"publish last 0x%02x cur 0x%02x\n", p->previous, p->current);                                  //@@@4.8
+		BL_LOG(5,"publish last 0x%02x cur 0x%02x\n", *previous, *current);                                      //@@@4.8
 
       // init publisher and add current onoff status
 
 		bt_mesh_model_msg_init(msg, BT_MESH_MODEL_OP_GEN_ONOFF_STATUS);
-		net_buf_simple_add_u8(msg, p->current);                           //@@@4.8
+		net_buf_simple_add_u8(msg, *current);                             //@@@4.8
 
 		  // publish mesh message and report potential error
 
@@ -361,15 +426,15 @@ static int gen_onoff_let_or_set(struct bt_mesh_model *model,
     // log the receive of GOOSET or GOOLET message and notify app level
 
   if (acked)
-	  LOG(4,BL_G "rcv [GOOSRV:SET @%d,%d]",p->id,p->current);
+	  LOG(4,BL_G "rcv [GOOSRV:SET @%d,%d]",idx+1,*current);
   else
-	  LOG(4,BL_G "rcv [GOOSRV:LET @%d,%d]",p->id,p->current);
+	  LOG(4,BL_G "rcv [GOOSRV:LET @%d,%d]",idx+1,*current);
 
-  goo_notify(p, acked);                  // notify application
+  goo_notify(idx, acked);                // notify application
 
     // finally update previous
 
-	p->previous = p->current;
+	*previous = *current;
 	return 0;
 }
 
@@ -417,6 +482,55 @@ static int gen_onoff_status(struct bt_mesh_model *model,
 	return 0;
 }
 
+//==============================================================================
+// vendor bulk update server message handler
+// - one message sets the on/off state of up to 32 elements, every element
+//   selected by mask is set like by a GOOLET to its generic on/off server
+// - the tiny core has no transitions, so TT, delay and a network start time
+//   are ignored (elements switch on receipt)
+// - repeated transactions are dropped by the shared de-ja-vu cache
+//==============================================================================
+
+static int vnd_bulk_set_unack(struct bt_mesh_model *model,
+			      struct bt_mesh_msg_ctx *ctx,
+			      struct net_buf_simple *buf)
+{
+	uint32_t mask, states;
+	uint8_t tid;
+	int64_t now = k_uptime_get();
+
+	if (buf->len >= 9) {    /* 32-bit mask and states */
+		mask = net_buf_simple_pull_le32(buf);
+		states = net_buf_simple_pull_le32(buf);
+	} else {                /* 16-bit mask and states */
+		mask = net_buf_simple_pull_le16(buf);
+		states = net_buf_simple_pull_le16(buf);
+	}
+	tid = net_buf_simple_pull_u8(buf);
+
+	if (bl_dejavu(model, ctx, tid, now))
+		return 0;                        // de-ja-vu: ignore repeat
+
+	bl_dejavu_add(model, ctx, tid, now);
+
+	LOG(4,BL_G "rcv [VNDSRV:BULK <#%d>,mask:%08x,states:%08x]",
+	    tid, mask, states);
+
+	for (int e=0; e < CFG_WL_ELEMENTS; e++)
+	{
+		if (!(mask & BIT(e)))
+			continue;
+
+		  // dummy GOOLET message, sufficient for the on/off server
+
+		NET_BUF_SIMPLE_DEFINE(msg, 1);
+		net_buf_simple_add_u8(&msg, (states >> e) & 1);
+		(void)gen_onoff_set_unack(goo_model(e,GOO_SRV), ctx, &msg);
+	}
+
+	return 0;
+}
+
 static int output_number(bt_mesh_output_action_t action, uint32_t number)
 {
 	LOG(1,BL_R "OOB Number %06u", number);
@@ -429,12 +543,97 @@ static int output_string(const char *str)
 	return 0;
 }
 
+//==============================================================================
+// LPN: friendship callbacks and radio event counting
+//==============================================================================
+
+  static struct
+  {
+    uint16_t friend;                   // friend address (0: no friendship)
+    uint8_t recv_win;                  // friend's receive window (ms)
+    int polls;                         // friend polls in report period
+    int tx;                            // advertising TX in report period
+    BL_ms since;                       // start of report period
+  } lpn;
+
+  static void lpn_count_tx(void)       // count network transmissions
+  {
+    lpn.tx += BT_MESH_TRANSMIT_COUNT(bt_mesh_net_transmit_get()) + 1;
+  }
+
+#if (CFG_LPN)
+
+  static void lpn_established(uint16_t net_idx, uint16_t friend_addr,
+                              uint8_t queue_size, uint8_t recv_win)
+  {
+    LOG(3,BL_G "LPN: friendship with 0x%04x (queue:%d, window:%d ms)",
+        friend_addr, queue_size, recv_win);
+    lpn.friend = friend_addr;
+    lpn.recv_win = recv_win;
+  }
+
+  static void lpn_terminated(uint16_t net_idx, uint16_t friend_addr)
+  {
+    LOG(3,BL_R "LPN: friendship with 0x%04x terminated", friend_addr);
+    lpn.friend = 0;
+  }
+
+  static void lpn_polled(uint16_t net_idx, uint16_t friend_addr, bool retry)
+  {
+    lpn.polls++;
+  }
+
+  BT_MESH_LPN_CB_DEFINE(lpn_cb) =
+  {
+    .established = lpn_established,
+    .terminated = lpn_terminated,
+    .polled = lpn_polled,
+  };
+
+  static void lpn_enable(void)         // start looking for a friend
+  {
+    int err = bt_mesh_lpn_set(true);
+    bl_err(err,"enable LPN failed");
+  }
+
+//==============================================================================
+// LPN: simulated power/duty report
+// - radio on time: one TX per network transmission, one TX plus the
+//   friend's receive window per poll
+//==============================================================================
+
+  static int lpn_report(void)
+  {
+    BL_ms now = bl_ms();
+    BL_ms ms = BL_MAX(1, now - lpn.since);
+
+    int64_t radio_us = (int64_t)lpn.tx * CFG_LPN_TX_US
+                     + (int64_t)lpn.polls * (CFG_LPN_TX_US + 1000*lpn.recv_win);
+    int ppm = (int)(radio_us * 1000 / ms);      // radio duty (ppm)
+    int ua = CFG_LPN_SLEEP_UA + (int)((int64_t)ppm * CFG_LPN_RADIO_UA / 1000000);
+    int days = CFG_LPN_BATTERY_MAH * 1000 / BL_MAX(ua,1) / 24;
+
+    LOG(2,BL_C "LPN: friend 0x%04x, %d polls, %d tx in %d s, radio duty "
+        "%d.%04d%%, ~%d uA, battery ~%d days (simulated)", lpn.friend,
+        lpn.polls, lpn.tx, (int)(ms/1000), ppm/10000, ppm%10000, ua, days);
+
+    lpn.polls = lpn.tx = 0;
+    lpn.since = now;
+    return 0;                          // OK
+  }
+
+#endif // CFG_LPN
+
 static void prov_complete(uint16_t net_idx, uint16_t addr)
 {
 	LOG(4,BL_Y "provisioning complete (net:0x%04x, addr:0x%04x)", net_idx, addr);
 	primary_addr = addr;
 	primary_net_idx = net_idx;
 
+  #if (CFG_LPN)
+	lpn_enable();                        // provisioned => look for a friend
+  #endif
+
 	_bl_post((PMI), _MESH_PRV_0_0_sts, 0,NULL,1);  // (BL_WL)<-[#MESH:PRV 1]
 }
 
@@ -520,27 +719,38 @@ static void bt_ready(int err)
 
 	bt_mesh_prov_enable(BT_MESH_PROV_GATT | BT_MESH_PROV_ADV);
 
+  #if (CFG_LPN)
+	if (bt_mesh_is_provisioned())
+		lpn_enable();                      // provisioned from settings
+  #endif
+
 	LOG(3,BL_C "init mesh complete");
 }
 
 //==============================================================================
 // publishing worker task
+// - publications are queued per element (latest value wins) and published
+//   back to back by one worker run; in LPN profile the worker is delayed by
+//   CFG_LPN_BATCH_MS, so bursts of button events share one radio window
 //==============================================================================
 
-  static int pub_id;                   // publish ID
-  static uint8_t pub_val;              // publish value
-  static uint16_t pub_op;              // mesh model opcode
+#if (CFG_WL_ELEMENTS > 32)
+  #error CFG_WL_ELEMENTS                 // pub_mask/bulk mask hold 32 elements
+#endif
+
+  static atomic_t pub_mask;            // elements with pending publication
+  static uint8_t pub_val[CFG_WL_ELEMENTS];   // publish value
+  static uint16_t pub_op[CFG_WL_ELEMENTS];   // mesh model opcode
 
-  static void pub_worker(struct k_work *work)
+  static void pub_one(uint8_t idx)
   {
     struct bt_mesh_model *mod_cli, *mod_srv;
 		struct bt_mesh_model_pub *pub_cli, *pub_srv;
-		uint8_t idx = pub_id-1;
 
-    mod_cli = mod_cli_sw[idx];
+    mod_cli = goo_model(idx,GOO_CLI);
     pub_cli = mod_cli->pub;
 
-    mod_srv = mod_srv_sw[idx];
+    mod_srv = goo_model(idx,GOO_SRV);
     pub_srv = mod_srv->pub;
 
 		/* If unprovisioned, just call the set function.
@@ -560,7 +770,7 @@ static void bt_ready(int err)
 
               // This is a dummy message sufficient for the led server
 
-            net_buf_simple_add_u8(&msg, pub_val);
+            net_buf_simple_add_u8(&msg, pub_val[idx]);
             (void)gen_onoff_set_unack(mod_srv, &ctx, &msg);
             return;
     }
@@ -568,20 +778,31 @@ static void bt_ready(int err)
     if (pub_cli->addr == BT_MESH_ADDR_UNASSIGNED)
             return;
 
-    BL_txt op = (pub_op == BT_MESH_MODEL_OP_GEN_ONOFF_SET) ? "SET" : "LET";
-    LOG(4,BL_G "pub [GOOCLI:%s @%d,%d]", op, pub_id,pub_val);
+    BL_txt op = (pub_op[idx] == BT_MESH_MODEL_OP_GEN_ONOFF_SET) ? "SET" : "LET";
+    LOG(4,BL_G "pub [GOOCLI:%s @%d,%d]", op, idx+1,pub_val[idx]);
 
     LOG(5,"publish to 0x%04x onoff 0x%04x idx 0x%04x",
-               pub_cli->addr, pub_val, idx);
-    bt_mesh_model_msg_init(pub_cli->msg,pub_op);
-    net_buf_simple_add_u8(pub_cli->msg, pub_val);
+               pub_cli->addr, pub_val[idx], idx);
+    bt_mesh_model_msg_init(pub_cli->msg,pub_op[idx]);
+    net_buf_simple_add_u8(pub_cli->msg, pub_val[idx]);
     net_buf_simple_add_u8(pub_cli->msg, trans_id++);
 
     int err = bt_mesh_model_publish(mod_cli);
     bl_err(err,"bt_mesh_model_publish");
+    if (!err)
+      lpn_count_tx();
   }
 
-  K_WORK_DEFINE(pub_work, pub_worker);      // assign work with workhorse
+  static void pub_worker(struct k_work *work)
+  {
+    atomic_val_t mask = atomic_set(&pub_mask,0);
+
+    for (int idx=0; idx < CFG_WL_ELEMENTS; idx++)
+      if (mask & BIT(idx))
+        pub_one(idx);                  // publish pending elements
+  }
+
+  K_WORK_DELAYABLE_DEFINE(pub_work, pub_worker);  // assign work with workhorse
 
 //==============================================================================
 // worker: publish GOO message
@@ -589,32 +810,35 @@ static void bt_ready(int err)
 
   static int pub(BL_ob *o,int val)   // here's how we hook in ...
   {
-    // id = 1..4, since it adresses elements 1..4
-    // button indices are 0..3, thus swnum = bl_ix(o) - 1
+    // id = 1..CFG_WL_ELEMENTS, since it adresses elements 1..CFG_WL_ELEMENTS
+    // button indices are 0..CFG_WL_ELEMENTS-1, thus swnum = bl_ix(o) - 1
 
-    if (bl_ix(o) < 1 || bl_ix(o) > 4)        // ignore IDs not in 1..4
+    if (bl_ix(o) < 1 || bl_ix(o) > CFG_WL_ELEMENTS)  // ignore bad IDs
       return -2;                       // ID OUT OF RANGE
 
-    pub_id = bl_ix(o);                    // store client ID (switch number)
-    pub_val = (uint8_t)val;            // store publish value
+    int idx = bl_ix(o) - 1;            // element index (switch number - 1)
 
     switch (o->op)
     {
       case SET_:
-        pub_op = BT_MESH_MODEL_OP_GEN_ONOFF_SET;
+        pub_op[idx] = BT_MESH_MODEL_OP_GEN_ONOFF_SET;
         break;
       case LET_:
-        pub_op = BT_MESH_MODEL_OP_GEN_ONOFF_SET_UNACK;
+        pub_op[idx] = BT_MESH_MODEL_OP_GEN_ONOFF_SET_UNACK;
         break;
       default:
         return -1;                     // bad message opcode
     }
 
-      // finally we submit a button press work, which refreshes the
-      // onoff state with the new value and publishes the state
+    pub_val[idx] = (uint8_t)val;       // store publish value
+    atomic_or(&pub_mask,BIT(idx));     // mark element as pending
+
+      // finally we schedule the publishing work, which refreshes the
+      // onoff state with the new value and publishes the state (a running
+      // batch window is not extended by further events)
 
     LOGO(3,"publish:",o,val);
-    k_work_submit(&pub_work);          // submit button work (that's all)
+    k_work_schedule(&pub_work, K_MSEC(CFG_LPN ? CFG_LPN_BATCH_MS : 0));
     return 0;                          // OK
   }
 
@@ -624,7 +848,7 @@ static void bt_ready(int err)
 
   static int sys_init(BL_ob *o, int val)
   {
-  	k_work_init(&pub_work, pub_worker);
+    pub_init();                        // tie publication buffers to contexts
 
       // init Bluetooth subsystem
 
@@ -644,6 +868,7 @@ static void bt_ready(int err)
 //                  +--------------------+
 //                  |        SYS:        | SYS input interface
 // (D)->     INIT ->|        (cb)        | init module, store (cb) callback
+// (D)->     TOCK ->|       @ix,cnt      | tock the module (LPN power report)
 //                  +--------------------+
 //                  |       #MESH:       | MESH output interface
 // (U)<-      PRV <-|       onoff        | provision on/off
@@ -680,6 +905,13 @@ static void bt_ready(int err)
         bl_install((D));               // install bl_deco in top gear
         return sys_init(o,val);        // delegate to sys_init() handler
 
+      case SYS_TOCK_ix_BL_pace_cnt:    // [SYS:TOCK @ix,cnt]
+      #if (CFG_LPN)
+        if (val % CFG_LPN_REPORT == 0)
+          return lpn_report();         // log simulated power/duty report
+      #endif
+        return 0;                      // OK
+
       case _MESH_PRV_0_0_sts:          // [#SET:PRV val]  (provision)
         prv = val;
         return bl_out(o,val,(U));      // output to subscriber
@@ -0,0 +1,370 @@
+//==============================================================================
+// bl_frame.c
+// framing layer (COBS or SLIP) on top of bl_uart
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluenetics. All rights reserved.
+//==============================================================================
+// - received bytes are bulk read from the UART RX ring directly into the
+//   frame buffer and decoded in place (COBS and SLIP decoding never grows),
+//   so a frame is emitted as one [UART:FRAME <buf>,len] message without any
+//   further copy; <buf> is valid for the duration of the message call
+// - a frame is encoded in one pass into the TX buffer (payload + CRC) and
+//   handed to bl_uart by a single bulk [UART:WRITE @len,<buf>]
+// - every encoded frame starts and ends with a delimiter, so a corrupted or
+//   truncated frame is terminated by the next one and dropped by CRC check
+//==============================================================================
+
+  #include <string.h>
+
+  #include "bluccino.h"
+  #include "bl_uart.h"
+  #include "bl_frame.h"
+
+//==============================================================================
+// PMI definition and logging shorthands
+//==============================================================================
+
+  #define PMI  bl_frame           // public module interface
+  #define WHO  "bl_frame:"        // who is logging?
+
+  #define LOG                     LOG_FRAME
+  #define LOGO(lvl,col,o,val)     LOGO_FRAME(lvl,col WHO,o,val)
+  #define LOG0(lvl,col,o,val)     LOGO_FRAME(lvl,col,o,val)
+
+//==============================================================================
+// framing constants
+//==============================================================================
+
+  #define CRC_SIZE      (CFG_FRAME_CRC ? 2 : 0)
+
+#if CFG_FRAME_SLIP
+  #define DELIM         0xC0      // SLIP END
+  #define ESC           0xDB      // SLIP ESC
+  #define ESC_END       0xDC      // escaped END
+  #define ESC_ESC       0xDD      // escaped ESC
+
+  #define RAW_SIZE      (2*(CFG_FRAME_SIZE+CRC_SIZE))      // worst case
+#else
+  #define DELIM         0x00      // COBS frame delimiter
+
+  #define RAW_SIZE      ((CFG_FRAME_SIZE+CRC_SIZE) +                      \
+                         (CFG_FRAME_SIZE+CRC_SIZE)/254 + 1)  // worst case
+#endif
+
+//==============================================================================
+// locals
+//==============================================================================
+
+  static BL_byte rxbuf[RAW_SIZE+1];   // raw frame + closing delimiter
+  static int rxlen = 0;               // number of raw bytes in rxbuf
+  static bool rxskip = false;         // skip until next delimiter (overrun)
+
+  static BL_byte txbuf[RAW_SIZE+2];   // encoded frame including delimiters
+
+  static int bad = 0;                 // number of dropped bad frames
+
+//==============================================================================
+// helper: CRC-16/CCITT (poly 0x1021, init 0xFFFF)
+//==============================================================================
+
+  static BL_word crc16(BL_word crc, const BL_byte *p, int n)
+  {
+    while (n--)
+    {
+      crc ^= (BL_word)(*p++) << 8;
+      for (int i=0; i < 8; i++)
+        crc = (crc & 0x8000) ? (BL_word)((crc << 1) ^ 0x1021)
+                             : (BL_word)(crc << 1);
+    }
+    return crc;
+  }
+
+#if CFG_FRAME_SLIP
+//==============================================================================
+// helper: SLIP decode in place, return decoded length (<0: bad escape)
+//==============================================================================
+
+  static int decode(BL_byte *p, int n)
+  {
+    int o = 0;
+
+    for (int i=0; i < n; i++)
+    {
+      BL_byte b = p[i];
+
+      if (b == ESC)
+      {
+        if (++i >= n)
+          return -1;
+        else if (p[i] == ESC_END)
+          b = DELIM;
+        else if (p[i] == ESC_ESC)
+          b = ESC;
+        else
+          return -1;
+      }
+      p[o++] = b;
+    }
+    return o;
+  }
+
+//==============================================================================
+// helper: SLIP encoder (usage: enc_begin(buf); enc_put(byte); ...)
+//==============================================================================
+
+  static BL_byte *tq;                 // encoder write pointer
+
+  static void enc_begin(BL_byte *q)
+  {
+    tq = q;
+  }
+
+  static void enc_put(BL_byte b)
+  {
+    if (b == DELIM)
+      *tq++ = ESC, *tq++ = ESC_END;
+    else if (b == ESC)
+      *tq++ = ESC, *tq++ = ESC_ESC;
+    else
+      *tq++ = b;
+  }
+
+#else // COBS
+//==============================================================================
+// helper: COBS decode in place, return decoded length (<0: bad code)
+// - in place is safe, since the write index always stays behind read index
+//==============================================================================
+
+  static int decode(BL_byte *p, int n)
+  {
+    int i = 0, o = 0;
+
+    while (i < n)
+    {
+      int code = p[i++];
+
+      if (code == 0 || i + code - 1 > n)
+        return -1;
+
+      for (int k=1; k < code; k++)
+        p[o++] = p[i++];
+
+      if (code < 0xFF && i < n)
+        p[o++] = 0;                   // implicit zero (not after last block)
+    }
+    return o;
+  }
+
+//==============================================================================
+// helper: COBS encoder (usage: enc_begin(buf); enc_put(byte); ...)
+// - a block of 254 non-zero bytes as last block leaves an empty trailing
+//   block (one more byte than minimal, decoded correctly anyway)
+//==============================================================================
+
+  static BL_byte *tq;                 // encoder write pointer
+  static BL_byte *tcode;              // code byte of current block
+
+  static void enc_begin(BL_byte *q)
+  {
+    tcode = q;  *tcode = 1;
+    tq = q+1;
+  }
+
+  static void enc_put(BL_byte b)
+  {
+    if (b != 0)
+    {
+      *tq++ = b;
+      if (++(*tcode) < 0xFF)
+        return;                       // block not yet full
+    }
+    tcode = tq++;                     // start new block
+    *tcode = 1;
+  }
+
+#endif // CFG_FRAME_SLIP
+
+//==============================================================================
+// helper: check and emit a raw frame (without delimiters)
+// - return true if a frame has been emitted
+//==============================================================================
+
+  static bool deliver(BL_byte *p, int n)
+  {
+    if (n == 0)
+      return false;                   // empty frame (back-to-back delimiters)
+
+    int len = decode(p,n);
+
+    if (len < CRC_SIZE)
+    {
+      bad++;
+      LOG(2,BL_R "bad frame encoding (%d bytes)" BL_0, n);
+      return false;
+    }
+
+    len -= CRC_SIZE;
+
+  #if CFG_FRAME_CRC
+    BL_word crc = ((BL_word)p[len] << 8) | p[len+1];
+    if (crc16(0xFFFF,p,len) != crc)
+    {
+      bad++;
+      LOG(2,BL_R "frame CRC error (%d bytes)" BL_0, len);
+      return false;
+    }
+  #endif
+
+    LOG(5,"received frame (%d bytes)", len);
+    _bl_msg((PMI), _UART,FRAME_, 0,p,len);  // [#UART:FRAME <buf>,len] -> (PMI)
+    return true;
+  }
+
+//==============================================================================
+// handler: [UART:AVAIL count] read raw bytes from UART and emit frames
+//==============================================================================
+
+  static int uart_avail(BL_ob *o, int val)
+  {
+    int frames = 0;
+
+    for (;;)
+    {
+      if (rxlen >= (int)sizeof(rxbuf))   // frame too large => drop it
+      {
+        bad++;
+        LOG(2,BL_R "frame overrun" BL_0);
+        rxlen = 0;  rxskip = true;
+      }
+
+      int n = bl_msg(bl_uart, _UART,READ_, sizeof(rxbuf)-rxlen,
+                     rxbuf+rxlen, 0);     // bulk read right into frame buffer
+      if (n <= 0)
+        break;
+
+      int start = 0, end = rxlen + n;
+
+      for (int i=rxlen; i < end; i++)
+      {
+        if (rxbuf[i] != DELIM)
+          continue;
+
+        if (rxskip)
+          rxskip = false;             // resync after overrun
+        else if (deliver(rxbuf+start, i-start))
+          frames++;
+
+        start = i+1;
+      }
+
+      rxlen = end - start;            // keep partial frame
+      if (start > 0 && rxlen > 0)
+        memmove(rxbuf, rxbuf+start, rxlen);
+    }
+
+    return frames;
+  }
+
+//==============================================================================
+// handler: [UART:FRAME <buf>,len] encode frame and write to UART
+//==============================================================================
+
+  static int uart_frame(BL_ob *o, int val)
+  {
+    const BL_byte *p = o->data;
+
+    if (val < 0 || val > CFG_FRAME_SIZE)
+      return bl_err(-1,"bl_frame: bad frame size");
+
+    txbuf[0] = DELIM;                 // terminate any garbage before
+    enc_begin(txbuf+1);
+
+    for (int i=0; i < val; i++)
+      enc_put(p[i]);
+
+  #if CFG_FRAME_CRC
+    BL_word crc = crc16(0xFFFF,p,val);
+    enc_put(crc >> 8);
+    enc_put(crc & 0xFF);
+  #endif
+
+    int n = tq - txbuf;
+    txbuf[n++] = DELIM;
+
+    for (int sent=0, waited=0; sent < n; )
+    {
+      int k = bl_msg(bl_uart, _UART,WRITE_, n-sent, txbuf+sent, 0);
+
+      if (k > 0)
+        sent += k;
+      else if (k < 0 || waited++ >= CFG_FRAME_TX_WAIT_MS)
+        return bl_err(-2,"bl_frame: UART TX stalled");
+      else
+        k_msleep(1);                  // wait for TX buffer to drain
+    }
+
+    LOG(5,"sent frame (%d bytes, %d encoded)", val, n);
+    return 0;
+  }
+
+//==============================================================================
+// public module interface
+//==============================================================================
+//
+// (D) := bl_down;  (U) := bl_up;  (L) := bl_uart
+//
+//                  +--------------------+
+//                  |      bl_frame      | framing layer
+//                  +--------------------+
+//                  |        SYS:        | SYS interface
+// (D)->     INIT ->|       <out>        | init module and bl_uart
+//                  +--------------------+
+//                  |        UART:       | UART input interface
+// (D)->    FRAME ->|     <buf>,len      | encode and write frame
+// (D)->    COUNT ->|                    | number of dropped bad frames
+// (L)->    AVAIL ->|       count        | bytes available => decode frames
+// (L)->     FULL ->|         0          | UART write buffer no more full
+//                  |....................|
+//                  |       #UART:       | UART output interface
+// (U)<-    FRAME <-|     <buf>,len      | received frame (CRC checked)
+//                  +--------------------+
+//
+//==============================================================================
+
+  int bl_frame(BL_ob *o, int val)
+  {
+    static BL_oval U = NULL;           // usually application
+
+    switch (bl_id(o))
+    {
+      case BL_ID(_SYS,INIT_):
+        U = bl_cb(o,(U),WHO"(U)");     // store callback
+        LOG(4,BL_B "init bl_frame (%s)", CFG_FRAME_SLIP ? "SLIP" : "COBS");
+        return bl_init(bl_uart,(PMI)); // bl_uart events go to bl_frame
+
+      case BL_ID(_UART,AVAIL_):
+        return uart_avail(o,val);      // delegate to uart_avail() handler
+
+      case BL_ID(_UART,FULL_):
+        return 0;                      // uart_frame() is waiting anyway
+
+      case BL_ID(_UART,FRAME_):
+        return uart_frame(o,val);      // delegate to uart_frame() handler
+
+      case BL_ID(_UART,COUNT_):
+        return bad;                    // number of dropped bad frames
+
+      case _BL_ID(_UART,FRAME_):
+        return bl_out(o,val,(U));      // send event to up gear
+
+      default:
+        return -1;
+    }
+  }
+
+//==============================================================================
+// cleanup (needed for *.c file merge of the bluccino core)
+//==============================================================================
+
+  #include "bl_clean.h"
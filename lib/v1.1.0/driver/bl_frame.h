@@ -0,0 +1,75 @@
+//==============================================================================
+// bl_frame.h
+// framing layer (COBS or SLIP) on top of bl_uart
+//
+// Created by Hugo Pristauz on 2022-Oct-18
+// Copyright © 2022 Bluenetics. All rights reserved.
+//==============================================================================
+// usage: bl_init(bl_frame,app);   // also inits bl_uart with bl_frame as <out>
+//
+//   app receives [UART:FRAME <buf>,len] per received frame (CRC checked)
+//   app sends    [UART:FRAME <buf>,len] to bl_frame to transmit a frame
+//
+// note: received frames are decoded in place in the single RX frame buffer
+//       of bl_frame. <buf> is only valid during the [UART:FRAME] call and is
+//       overwritten by the next frame, so a receiver that needs the data
+//       later must copy it before returning.
+//==============================================================================
+
+#ifndef __BL_FRAME_H__
+#define __BL_FRAME_H__
+
+//==============================================================================
+// FRAME Logging
+//==============================================================================
+
+  #ifndef CFG_LOG_FRAME
+    #define CFG_LOG_FRAME    1           // FRAME logging is by default on
+  #endif
+
+  #if (CFG_LOG_FRAME)
+    #define LOG_FRAME(l,f,...)    BL_LOG(CFG_LOG_FRAME-1+l,f,##__VA_ARGS__)
+    #define LOGO_FRAME(l,f,o,v)   bl_logo(CFG_LOG_FRAME-1+l,f,o,v)
+  #else
+    #define LOG_FRAME(l,f,...)    {}     // empty
+    #define LOGO_FRAME(l,f,o,v)   {}     // empty
+  #endif
+
+//==============================================================================
+// configuration
+// - CFG_FRAME_SLIP: use SLIP (RFC 1055) framing, otherwise COBS framing
+// - CFG_FRAME_CRC: append/check CRC-16/CCITT (2 bytes, MSB first) per frame
+// - CFG_FRAME_SIZE: max size of a frame payload (excluding CRC)
+// - CFG_FRAME_TX_WAIT_MS: max time to wait for UART TX buffer space
+//==============================================================================
+
+  #ifndef CFG_FRAME_SLIP
+    #define CFG_FRAME_SLIP        0      // COBS by default
+  #endif
+
+  #ifndef CFG_FRAME_CRC
+    #define CFG_FRAME_CRC         1      // CRC check by default
+  #endif
+
+  #ifndef CFG_FRAME_SIZE
+    #define CFG_FRAME_SIZE      256
+  #endif
+
+  #ifndef CFG_FRAME_TX_WAIT_MS
+    #define CFG_FRAME_TX_WAIT_MS 100
+  #endif
+
+//==============================================================================
+// message definitions
+//==============================================================================
+
+  #define UART_FRAME_0_buf_len  BL_ID(_UART,FRAME_) // [UART:FRAME <buf>,len]
+  #define UART_COUNT_0_0_0      BL_ID(_UART,COUNT_) // [UART:COUNT] bad frames
+
+//==============================================================================
+// public module interface
+//==============================================================================
+
+  int bl_frame(BL_ob *o, int val);
+
+#endif // __BL_FRAME_H__
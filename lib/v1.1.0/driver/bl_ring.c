@@ -1,5 +1,5 @@
 //==============================================================================
-// bl_ring.c 
+// bl_ring.c
 // ring buffer support
 //
 // Created by Hugo Pristauz on 2022-Aug-06
@@ -7,10 +7,10 @@
 //==============================================================================
 // Howto:
 //
-//   BL_byte rxbuf[128];
+//   BL_byte rxbuf[128];               // size must be a power of 2
 //   BL_ring rxring;
 //
-//   bl_ring_init(&rxring,&rxbuf,sizeof(rxbuf));
+//   bl_ring_init(&rxring,rxbuf,sizeof(rxbuf));
 //
 //     // put into receiver ring buffer
 //     // note: bl_ring_put() would ignore for true bl_ring_full()
@@ -27,26 +27,47 @@
 //      if ( bl_ring_avail(&rxring) )
 //          byte = bl_ring_get(&rxring);
 //
+//     // bulk transfer
+//
+//   BL_byte data[32];
+//   uint32_t n = bl_ring_get_n(&rxring,data,sizeof(data));
+//
+//==============================================================================
+// memory ordering
+// - the producer publishes data by a release store of .head after writing the
+//   data, the consumer acquires .head before reading the data (and vice versa
+//   for .tail), which makes the ring lock free on single and multi core
 //==============================================================================
 
   #include <assert.h>
+  #include <string.h>
 
-  #include "bluccino.h"
   #include "bl_ring.h"
 
+  #define LOAD(p)         __atomic_load_n(p,__ATOMIC_ACQUIRE)
+  #define STORE(p,v)      __atomic_store_n(p,v,__ATOMIC_RELEASE)
+
 //==============================================================================
-// check if ring buffer is full
+// fill level
 //==============================================================================
 
-  bool bl_ring_full(BL_ring *r)
+  uint32_t bl_ring_count(BL_ring *r)   // number of bytes in ring buffer
   {
-    BL_byte avail;
+    return LOAD(&r->head) - LOAD(&r->tail);
+  }
 
-    bl_irq(0);                         // disable IRQ;
-    avail = r->avail;
-    bl_irq(1);                         // enable IRQ;
+  uint32_t bl_ring_space(BL_ring *r)   // number of free bytes
+  {
+    return (r->mask + 1) - bl_ring_count(r);
+  }
 
-    return (avail >= r->size);
+//==============================================================================
+// check if ring buffer is full
+//==============================================================================
+
+  bool bl_ring_full(BL_ring *r)
+  {
+    return bl_ring_space(r) == 0;
   }
 
 //==============================================================================
@@ -55,18 +76,16 @@
 
   void bl_ring_put(BL_ring *r, BL_byte byte)     // put byte into ring buffer
   {                                              // ignore if full
-    if ( bl_ring_full(r) )
+    uint32_t head = r->head;                     // own index (producer)
+
+    if (head - LOAD(&r->tail) > r->mask)
     {
-        r->overflow++;                 // count overflow (health impacted)
-        return;
+      r->overflow++;                   // count overflow (health impacted)
+      return;
     }
 
-    r->buf[r->iput] = byte;           // put byte into ring buffer at head position
-    bl_irq(0);  // disable IRQ;
-    r->avail++;
-    bl_irq(1);  // enable IRQ;
-
-    r->iput = (r->iput + 1) % r->size;
+    r->buf[head & r->mask] = byte;     // put byte at head position
+    STORE(&r->head, head+1);           // publish byte
   }
 
 //==============================================================================
@@ -75,11 +94,7 @@
 
   bool bl_ring_avail(BL_ring *r)       // is a byte available in ring buffer?
   {
-    BL_byte avail;
-    bl_irq(0);  // disable IRQ;
-    avail = r->avail;
-    bl_irq(1);  // enable IRQ;
-    return avail > 0;                  // return availability status
+    return bl_ring_count(r) > 0;       // return availability status
   }
 
 //==============================================================================
@@ -88,31 +103,121 @@
 
   BL_byte bl_ring_get(BL_ring *r)      // get byte from ring buffer
   {
-    BL_byte byte = 0xFF;               // default init (if no byte available)
-    if ( !bl_ring_avail(r) )
-        r->underflow++;                // count underflows (health impact)
-    else
+    uint32_t tail = r->tail;           // own index (consumer)
+
+    if (LOAD(&r->head) == tail)
     {
-        byte = r->buf[r->iget];       // take byte at tail position
-        bl_irq(0);  // disable IRQ;
-        r->avail--;
-        bl_irq(1);  // enable IRQ;
-        r->iget = (r->iget + 1) % r->size;
+      r->underflow++;                  // count underflows (health impact)
+      return 0xFF;                     // default (if no byte available)
     }
+
+    BL_byte byte = r->buf[tail & r->mask];       // take byte at tail position
+    STORE(&r->tail, tail+1);           // release slot
     return byte;
   }
 
+//==============================================================================
+// zero copy access: producer side
+//==============================================================================
+
+  uint32_t bl_ring_put_claim(BL_ring *r, BL_byte **p, uint32_t n)
+  {
+    uint32_t head = r->head;
+    uint32_t space = (r->mask + 1) - (head - LOAD(&r->tail));
+    uint32_t ix = head & r->mask;
+    uint32_t contig = (r->mask + 1) - ix;        // bytes up to buffer end
+
+    n = n < space ? n : space;
+    n = n < contig ? n : contig;
+
+    *p = r->buf + ix;
+    return n;
+  }
+
+  void bl_ring_put_finish(BL_ring *r, uint32_t n)
+  {
+    STORE(&r->head, r->head + n);      // publish n bytes
+  }
+
+//==============================================================================
+// zero copy access: consumer side
+//==============================================================================
+
+  uint32_t bl_ring_get_claim(BL_ring *r, const BL_byte **p, uint32_t n)
+  {
+    uint32_t tail = r->tail;
+    uint32_t count = LOAD(&r->head) - tail;
+    uint32_t ix = tail & r->mask;
+    uint32_t contig = (r->mask + 1) - ix;        // bytes up to buffer end
+
+    n = n < count ? n : count;
+    n = n < contig ? n : contig;
+
+    *p = r->buf + ix;
+    return n;
+  }
+
+  void bl_ring_get_finish(BL_ring *r, uint32_t n)
+  {
+    STORE(&r->tail, r->tail + n);      // release n bytes
+  }
+
+//==============================================================================
+// bulk access (at most two memcpy's per call)
+//==============================================================================
+
+  uint32_t bl_ring_put_n(BL_ring *r, const BL_byte *data, uint32_t n)
+  {
+    uint32_t done = 0;
+    BL_byte *p;
+
+    for (int i=0; i < 2 && done < n; i++)        // wrap => 2nd region
+    {
+      uint32_t k = bl_ring_put_claim(r,&p,n-done);
+      if (k == 0)
+        break;
+      memcpy(p,data+done,k);
+      bl_ring_put_finish(r,k);
+      done += k;
+    }
+
+    if (done < n)
+      r->overflow++;                   // count overflow (health impacted)
+    return done;
+  }
+
+  uint32_t bl_ring_peek(BL_ring *r, BL_byte *data, uint32_t n)
+  {
+    uint32_t tail = r->tail;
+    uint32_t count = LOAD(&r->head) - tail;
+    uint32_t ix = tail & r->mask;
+    uint32_t contig = (r->mask + 1) - ix;
+
+    n = n < count ? n : count;
+
+    uint32_t k = n < contig ? n : contig;
+    memcpy(data, r->buf + ix, k);
+    memcpy(data + k, r->buf, n - k);   // wrapped part (may be empty)
+    return n;
+  }
+
+  uint32_t bl_ring_get_n(BL_ring *r, BL_byte *data, uint32_t n)
+  {
+    n = bl_ring_peek(r,data,n);
+    STORE(&r->tail, r->tail + n);      // release n bytes
+    return n;
+  }
+
 //==============================================================================
 // init ring buffer
 //==============================================================================
 
-  void bl_ring_init(BL_ring *r, BL_byte *buf, BL_byte size) // init ring buffer
+  void bl_ring_init(BL_ring *r, BL_byte *buf, uint32_t size) // init ring buffer
   {
-    assert(size > 0);
-    r->iput = r->iget = r->avail = 0;
+    assert(size > 0 && (size & (size-1)) == 0);  // power of 2
+    r->head = r->tail = 0;
     r->underflow = 0;                  // health counter (for underflow)
     r->overflow = 0;                   // health counter (for overflow)
     r->buf = buf;
-    r->size = size;
-    r->avail = 0;
+    r->mask = size - 1;
   }
@@ -5,12 +5,19 @@
 // Created by Hugo Pristauz on 2022-Aug-06
 // Copyright © 2022 Blunetics. All rights reserved.
 //==============================================================================
+// - lock free single producer / single consumer (SPSC) byte ring: the
+//   producer (e.g. an ISR) only writes .head, the consumer only writes .tail,
+//   so no interrupt locking is needed
+// - size must be a power of 2, indices are free running 32-bit counters
+//   (wrap-around by masking, no % operation, no 255 byte limit)
+// - bulk access: bl_ring_put_n(), bl_ring_get_n(), bl_ring_peek()
+// - zero copy access: claim a contiguous region, fill/read it in place and
+//   finish it with the number of bytes actually used
+//==============================================================================
 
 #ifndef __BL_RING_H__
 #define __BL_RING_H__
 
-//  #include <stdbool.h>
-//  #include <stdint.h>
   #include "bl_type.h"
 
 //==============================================================================
@@ -27,35 +34,69 @@
 
   typedef struct BL_ring
   {
-      BL_byte iput;                    // put index
-      BL_byte iget;                    // get index
-      BL_byte avail;                   // number of bytes in ring buffer
+      uint32_t head;                   // put counter (written by producer)
+      uint32_t tail;                   // get counter (written by consumer)
+      uint32_t mask;                   // size - 1 (size is power of 2)
 
       BL_byte *buf;                    // ring buffer memory
-      BL_byte size;
 
       BL_word underflow;               // underflow error count
       BL_word overflow;                // overflow error count
   } BL_ring;
 
 //==============================================================================
-// put byte into ring buffer
+// put byte into ring buffer (producer)
 //==============================================================================
 
   bool bl_ring_full(BL_ring *r);                 // is ring buffer full?
   void bl_ring_put(BL_ring *r, BL_byte byte);    // put byte into ring buffer
 
 //==============================================================================
-// get byte from ring buffer
+// get byte from ring buffer (consumer)
 //==============================================================================
 
   bool bl_ring_avail(BL_ring *r);      // is a byte available in ring buffer?
   BL_byte bl_ring_get(BL_ring *r);     // get byte from ring buffer
 
 //==============================================================================
-// ring buffer init
+// fill level
+//==============================================================================
+
+  uint32_t bl_ring_count(BL_ring *r);  // number of bytes in ring buffer
+  uint32_t bl_ring_space(BL_ring *r);  // number of free bytes
+
+//==============================================================================
+// bulk access (return number of bytes actually transferred)
+// - usage: n = bl_ring_put_n(&ring,data,len);  // producer
+//          n = bl_ring_get_n(&ring,data,len);  // consumer
+//          n = bl_ring_peek(&ring,data,len);   // consumer, data stays in ring
+//==============================================================================
+
+  uint32_t bl_ring_put_n(BL_ring *r, const BL_byte *data, uint32_t n);
+  uint32_t bl_ring_get_n(BL_ring *r, BL_byte *data, uint32_t n);
+  uint32_t bl_ring_peek(BL_ring *r, BL_byte *data, uint32_t n);
+
+//==============================================================================
+// zero copy access (claim returns size of contiguous region, maybe < n)
+// - usage: BL_byte *p;                           // producer
+//          n = bl_ring_put_claim(&ring,&p,len);  // claim free region
+//          memcpy(p,data,n);                     // fill region in place
+//          bl_ring_put_finish(&ring,n);          // commit n bytes
+// -        const BL_byte *q;                     // consumer
+//          n = bl_ring_get_claim(&ring,&q,len);  // claim filled region
+//          process(q,n);                         // read region in place
+//          bl_ring_get_finish(&ring,n);          // release n bytes
+//==============================================================================
+
+  uint32_t bl_ring_put_claim(BL_ring *r, BL_byte **p, uint32_t n);
+  void bl_ring_put_finish(BL_ring *r, uint32_t n);
+  uint32_t bl_ring_get_claim(BL_ring *r, const BL_byte **p, uint32_t n);
+  void bl_ring_get_finish(BL_ring *r, uint32_t n);
+
+//==============================================================================
+// ring buffer init (size must be a power of 2)
 //==============================================================================
 
-  void bl_ring_init(BL_ring *r, BL_byte *buf, BL_byte size);
+  void bl_ring_init(BL_ring *r, BL_byte *buf, uint32_t size);
 
 #endif // __BL_RING_H__
@@ -203,6 +203,197 @@
     return spi_transceive(spi->dev, &spi->cfg, &tx, &rx);
   }
 
+//==============================================================================
+// transaction queue: [SPI:SEND @tag,<BL_spi>] queues a transaction on the bus
+// of spi->dev and returns immediately. Transactions of a bus run one after the
+// other, each with its own spi_config (devices on a bus share the controller
+// but keep their own chip select). With CFG_SPI_ASYNC the transfer runs by
+// spi_transceive_cb(); its callback (ISR context) only posts the completion to
+// the work queue, since the SPI context is still locked during the callback.
+// In work queue context the finished transaction is unlinked, the next one
+// started, and [SPI:READY @tag,<BL_spi>,err] is emitted to <out>.
+//
+//      bus[i].dev ---> SPI controller
+//      bus[i].head --> BL_spi --next--> BL_spi --next--> BL_spi
+//                      (in flight)                         ^
+//      bus[i].tail ----------------------------------------+
+//==============================================================================
+
+  typedef struct BL_spibus
+          {
+            const struct device *dev;  // SPI controller (NULL: free slot)
+            BL_spi *head;              // in flight transaction
+            BL_spi *tail;              // last queued transaction
+            struct spi_buf_set tx;     // buffer sets of in flight transaction
+            struct spi_buf_set rx;
+          } BL_spibus;
+
+  static BL_spibus bus[CFG_SPI_BUSES];
+  static struct k_spinlock lock;
+
+  static BL_wqmsg inbox[CFG_SPI_QUEUE];
+  static BL_workq wq = BL_WORKQ(PMI,inbox,false);
+
+//==============================================================================
+// helper: find (or allocate) bus entry of SPI controller
+//==============================================================================
+
+  static BL_spibus *spi_bus(const struct device *dev)
+  {
+    BL_spibus *slot = NULL;
+
+    for (int i=0; i < CFG_SPI_BUSES; i++)
+    {
+      if (bus[i].dev == dev)
+        return bus + i;
+      if (bus[i].dev == NULL && slot == NULL)
+        slot = bus + i;
+    }
+
+    if (slot)
+      slot->dev = dev;
+    return slot;                       // NULL if out of bus entries
+  }
+
+//==============================================================================
+// helper: post completion [#SPI:READY @tag,<BL_spi>,err] to work queue
+//==============================================================================
+
+  static void spi_post(BL_spi *spi, int err)
+  {
+    BL_ob oo = _BL_OB(_SPI,READY_,spi->tag,spi);
+
+    if (bl_enqueue(&wq,&oo,err) < 0)
+      LOG(1,BL_R "SPI completion lost (inbox full)" BL_0);
+  }
+
+#if (CFG_SPI_ASYNC)
+//==============================================================================
+// callback: SPI transfer complete (ISR context)
+//==============================================================================
+
+  static void spi_done(const struct device *dev, int result, void *data)
+  {
+    BL_spibus *b = data;
+    spi_post(b->head,result);          // to be continued in work queue context
+  }
+#endif
+
+//==============================================================================
+// helper: start head transaction of bus (thread context)
+//==============================================================================
+
+  static void spi_begin(BL_spibus *b)
+  {
+    BL_spi *spi = b->head;
+
+    b->tx.buffers = spi->tx.buffers;
+    b->tx.count = spi->tx.count;
+
+    b->rx.buffers = spi->rx.buffers;
+    b->rx.count = spi->rx.count;
+
+  #if (CFG_SPI_ASYNC)
+    int err = spi_transceive_cb(spi->dev, &spi->cfg,
+                                b->tx.count ? &b->tx : NULL,
+                                b->rx.count ? &b->rx : NULL, spi_done, b);
+    if (err)
+      spi_post(spi,err);               // failed to start => complete now
+  #else
+    spi_post(spi,spi_transceive(spi->dev, &spi->cfg,
+                                b->tx.count ? &b->tx : NULL,
+                                b->rx.count ? &b->rx : NULL));
+  #endif
+  }
+
+//==============================================================================
+// queue transaction
+// - usage: bl_spi_tx(&spi,0,buf0,size0)    // write buffer @0
+//          bl_spi_rx(&spi,0,buf1,size1)    // read buffer @0
+//          err = bl_spi_send(&spi,tag)     // [SPI:READY @tag,<BL_spi>,err]
+//==============================================================================
+
+#if (!CFG_SPI_DIRECT_API)
+  static
+#endif
+
+  int bl_spi_send(BL_spi *spi, int tag)
+  {
+    bool start;
+
+    if (spi->queued)
+      return bl_err(-EBUSY,"bl_spi_send: transaction already queued");
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    BL_spibus *b = spi_bus(spi->dev);
+
+    if (b == NULL)
+    {
+      k_spin_unlock(&lock,key);
+      return bl_err(-ENOMEM,"bl_spi_send: too many SPI buses");
+    }
+
+    spi->tag = tag;
+    spi->next = NULL;
+    spi->queued = true;
+
+    start = (b->head == NULL);         // bus idle?
+    if (start)
+      b->head = spi;
+    else
+      b->tail->next = spi;
+    b->tail = spi;
+
+    k_spin_unlock(&lock,key);
+
+    if (start)
+      spi_begin(b);
+    return 0;
+  }
+
+//==============================================================================
+// handler: [#SPI:READY @tag,<BL_spi>,err] transaction complete (work queue)
+//==============================================================================
+
+  static int spi_ready_(BL_ob *o, int val)
+  {
+    BL_spi *spi = bl_data(o);
+    BL_spibus *b = NULL;
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    for (int i=0; i < CFG_SPI_BUSES; i++)
+      if (bus[i].dev == spi->dev)
+        b = bus + i;
+
+    b->head = spi->next;               // unlink finished transaction
+    if (b->head == NULL)
+      b->tail = NULL;
+
+    spi->next = NULL;
+    spi->queued = false;
+
+    k_spin_unlock(&lock,key);
+
+    if (b->head)
+      spi_begin(b);                    // start next transaction of bus
+
+    if (val)
+      LOG(2,BL_R "SPI transaction @%d failed (%d)" BL_0, bl_ix(o),val);
+    return 0;
+  }
+
+//==============================================================================
+// handler: [SPI:SEND @tag,<BL_spi>] queue transaction
+//==============================================================================
+
+  static int spi_send_(BL_ob *o, int val)
+  {
+    BL_spi *spi = bl_data(o);          // pointer to SPI control structure
+
+    return bl_spi_send(spi,bl_ix(o));
+  }
+
 //==============================================================================
 // handler: [SPI:TRANS <BL_spi>] transmit to/from SPI device
 //==============================================================================
@@ -285,12 +476,12 @@
 // public module interface
 //==============================================================================
 //
-// (D) := bl_spi;
+// (D) := bl_spi;  (U) := bl_up;
 //                  +--------------------+
 //                  |       bl_spi       | SPI driver
 //                  +--------------------+
 //                  |        SYS:        | SYS input interface
-// (D)->     INIT ->|        (cb)        | system init
+// (D)->     INIT ->|        (cb)        | system init, store <out> callback
 //                  +--------------------+
 //                  |        SPI:        | SPI input interface
 // (D)->     INIT ->|      <BL_spi>      | init SPI device
@@ -299,16 +490,23 @@
 // (D)->    TRANS ->|      <BL_spi>      | transmit to/from SPI device
 // (D)->       TX ->|    @ix,<BL_xmit>   | setup TX buffer @ix
 // (D)->       RX ->|    @ix,<BL_xmit>   | setup RX buffer @ix
+// (D)->     SEND ->|   @tag,<BL_spi>    | queue transaction (non blocking)
+//                  |....................|
+//                  |        SPI:        | SPI output interface
+// (U)<-    READY <-| @tag,<BL_spi>,err  | queued transaction complete
 //                  +--------------------+
 //
 //==============================================================================
 
   int bl_spi(BL_ob *o, int val)
   {
+    static BL_oval U = NULL;           // <out> for completion events
+
     switch (bl_id(o))                  // dispatch message ID
     {
       case BL_ID(_SYS,INIT_):          // [SYS:INIT <cb>] init module
-        return 0;                      // nothing to do
+        U = bl_cb(o,(U),WHO"(U)");     // store callback
+        return 0;
 
       case BL_ID(_SPI,INIT_):          // [SPI:WRITE <BL_spi>]
         return spi_init_(o,val);       // delegate to spi_init_() handler
@@ -328,6 +526,13 @@
       case BL_ID(_SPI,RX_):            // [SPI:RX @ix,<BL_xmit>]
         return spi_rx_(o,val);         // delegate to spi_rx_() handler
 
+      case BL_ID(_SPI,SEND_):          // [SPI:SEND @tag,<BL_spi>]
+        return spi_send_(o,val);       // delegate to spi_send_() handler
+
+      case _BL_ID(_SPI,READY_):        // [#SPI:READY @tag,<BL_spi>,err]
+        spi_ready_(o,val);             // unlink, start next transaction
+        return bl_out(o,val,(U));      // post completion to <out>
+
       default:
         LOGO(1,BL_R "undispatched::",o,val);
         return -1;                     // bad arg
@@ -20,6 +20,22 @@
   #define CFG_SPI_DIRECT_API    0      // no direct API per default
 #endif
 
+#ifndef CFG_SPI_ASYNC
+  #if defined(CONFIG_SPI_ASYNC)
+    #define CFG_SPI_ASYNC       1      // [SPI:SEND] runs interrupt driven
+  #else
+    #define CFG_SPI_ASYNC       0      // [SPI:SEND] runs blocking
+  #endif
+#endif
+
+#ifndef CFG_SPI_BUSES
+  #define CFG_SPI_BUSES         2      // max number of SPI buses for [SPI:SEND]
+#endif
+
+#ifndef CFG_SPI_QUEUE
+  #define CFG_SPI_QUEUE         8      // completion inbox size (power of 2)
+#endif
+
 //==============================================================================
 // SPI Logging
 //==============================================================================
@@ -60,6 +76,9 @@
             struct spi_config cfg;      // init with {0}
             BL_spi_buf_set tx;
             BL_spi_buf_set rx;
+            struct BL_spi *next;        // next queued transaction on bus
+            int tag;                    // [SPI:SEND @tag] for completion
+            bool queued;                // queued or in flight
           } BL_spi;
 
   #define BL_SPI(txbufs,rxbufs)                                         \
@@ -87,6 +106,7 @@
   int bl_spi_write(BL_spi *spi);
   int bl_spi_read(BL_spi *spi);
   int bl_spi_trans(BL_spi *spi);
+  int bl_spi_send(BL_spi *spi, int tag);
 
 #endif
 
@@ -162,4 +182,18 @@
     return _bl_msg((to), _SPI,TRANS_, 0,spi,0);
   }
 
+//==============================================================================
+// syntactic sugar: queue transaction (returns immediately)
+// - usage: _SPI_TX(&spi,0, txbuf0,size0, (to))  // setup TX buffer @0
+//          _SPI_RX(&spi,0, rxbuf0,size0, (to))  // setup RX buffer @0
+//          err = _SPI_SEND(&spi,tag, (to))      // queue transaction
+// - completion is posted as [SPI:READY @tag,<BL_spi>,err] to <out>, buffers
+//   and BL_spi structure must stay untouched until then
+//==============================================================================
+
+  static inline int _SPI_SEND(BL_spi *spi,int tag, BL_oval to)
+  {
+    return _bl_msg((to), _SPI,SEND_, tag,spi,0);
+  }
+
 #endif // __BL_SPI_H__
@@ -26,20 +26,70 @@
   #define LOGO(lvl,col,o,val)     LOGO_UART(lvl,col WHO,o,val)
   #define LOG0(lvl,col,o,val)     LOGO_UART(lvl,col,o,val)
 
+//==============================================================================
+// configuration
+// - CFG_UART_ASYNC: use the async (DMA) UART API with double buffered RX and
+//   idle line delivery, otherwise interrupt driven FIFO access (IRQ per byte)
+// - CFG_UART_BAUDRATE: UART baud rate
+// - CFG_UART_RX_SIZE: RX ring buffer size (power of 2)
+// - CFG_UART_TX_SIZE: TX ring buffer size (power of 2, async mode only)
+// - CFG_UART_DMA_SIZE: size of each of the two RX DMA buffers (async mode)
+// - CFG_UART_RX_TIMEOUT_US: idle line time after which a partially filled
+//   DMA buffer is delivered (async mode)
+//==============================================================================
+
+  #ifndef CFG_UART_ASYNC
+    #if defined(CONFIG_UART_ASYNC_API)
+      #define CFG_UART_ASYNC        1   // async if async UART API is enabled
+    #else
+      #define CFG_UART_ASYNC        0   // interrupt driven
+    #endif
+  #endif
+
+  #ifndef CFG_UART_BAUDRATE
+    #define CFG_UART_BAUDRATE   57600
+  #endif
+
+  #ifndef CFG_UART_RX_SIZE
+    #if CFG_UART_ASYNC
+      #define CFG_UART_RX_SIZE   1024   // 10ms @ 1 Mbaud
+    #else
+      #define CFG_UART_RX_SIZE    128
+    #endif
+  #endif
+
+  #ifndef CFG_UART_TX_SIZE
+    #define CFG_UART_TX_SIZE     1024
+  #endif
+
+  #ifndef CFG_UART_DMA_SIZE
+    #define CFG_UART_DMA_SIZE     256
+  #endif
+
+  #ifndef CFG_UART_RX_TIMEOUT_US
+    #define CFG_UART_RX_TIMEOUT_US 100  // ~10 characters @ 1 Mbaud
+  #endif
+
+  #if (CFG_UART_RX_SIZE & (CFG_UART_RX_SIZE-1)) || \
+      (CFG_UART_TX_SIZE & (CFG_UART_TX_SIZE-1))
+    #error "bl_uart: CFG_UART_RX_SIZE and CFG_UART_TX_SIZE must be powers of 2"
+  #endif
+
 //==============================================================================
 // locals
 //==============================================================================
 
   static const struct device *uart = NULL;
 
+  static BL_wqmsg inbox[2];            // [#UART:AVAIL] and [#UART:FULL]
+  static BL_workq wq = BL_WORKQ(PMI,inbox,true);  // coalesce ISR events
+
 //==============================================================================
 // ring buffer
 //==============================================================================
 
-    #define RING_BUFFER_SIZE 128
-
     static BL_ring rxring;
-    static BL_byte  rxbuf[RING_BUFFER_SIZE];
+    static BL_byte  rxbuf[CFG_UART_RX_SIZE];
 
 //==============================================================================
 // helper: init ring buffer
@@ -48,9 +98,10 @@
   static void ring_init(void)
   {
     LOG(4,"init RX ring buffer");
-    bl_ring_init(&rxring, rxbuf, RING_BUFFER_SIZE);
+    bl_ring_init(&rxring, rxbuf, CFG_UART_RX_SIZE);
   }
 
+#if !CFG_UART_ASYNC
 //==============================================================================
 // helper: drain UART
 //==============================================================================
@@ -69,7 +120,6 @@
 
   static void uart_isr(const struct device *unused, void *data)
   {
-    static BL_work work = BL_WORK(PMI);
     static BL_ob oo = _BL_OB(_UART,AVAIL_,0,NULL);
     int count = 0;
     BL_byte byte;
@@ -93,16 +143,123 @@
     }
 
     LOG(7,"UART receive: #%d",count);
-    bl_submit(&work,&oo,count);  // [#UART,AVAIL count] -> (PMI)
+    bl_enqueue(&wq,&oo,count);   // [#UART,AVAIL count] -> (PMI)
+  }
+
+#else // CFG_UART_ASYNC
+//==============================================================================
+// async mode: DMA receives into two buffers alternately, the driver reports
+// received data (UART_RX_RDY) when a buffer is full or the line got idle for
+// CFG_UART_RX_TIMEOUT_US, and we copy it in bulk into the RX ring. TX runs
+// from a TX ring, each DMA transfer sends the largest contiguous region.
+//==============================================================================
+
+  static BL_byte dmabuf[2][CFG_UART_DMA_SIZE];
+  static int dmaix = 0;                // next DMA buffer to provide
+
+  static BL_ring txring;
+  static BL_byte txbuf[CFG_UART_TX_SIZE];
+  static uint32_t txlen = 0;           // length of running DMA transfer
+  static atomic_t txbusy = 0;          // DMA transfer running
+  static atomic_t txfull = 0;          // writer has seen a full TX ring
+
+//==============================================================================
+// helper: start RX (first DMA buffer now, second on UART_RX_BUF_REQUEST)
+//==============================================================================
+
+  static int rx_start(void)
+  {
+    dmaix = 1;                         // next buffer to provide
+    return uart_rx_enable(uart, dmabuf[0], CFG_UART_DMA_SIZE,
+                          CFG_UART_RX_TIMEOUT_US);
+  }
+
+//==============================================================================
+// helper: start DMA transfer of pending TX data (thread or ISR context)
+// - the txbusy flag makes the caller winning the race the single consumer
+//==============================================================================
+
+  static void tx_kick(void)
+  {
+    const BL_byte *p;
+
+    while (bl_ring_count(&txring) && atomic_cas(&txbusy,0,1))
+    {
+      txlen = bl_ring_get_claim(&txring, &p, CFG_UART_TX_SIZE);
+      if (uart_tx(uart, p, txlen, SYS_FOREVER_US) == 0)
+        return;                        // TX_DONE will release and continue
+
+      txlen = 0;                       // driver refused (should not happen)
+      atomic_clear(&txbusy);
+      break;
+    }
+  }
+
+//==============================================================================
+// isr: UART async event callback
+//==============================================================================
+
+  static void uart_cb(const struct device *dev, struct uart_event *evt,
+                      void *data)
+  {
+    static BL_ob avail = _BL_OB(_UART,AVAIL_,0,NULL);
+    static BL_ob full = _BL_OB(_UART,FULL_,0,NULL);
+
+    switch (evt->type)
+    {
+      case UART_RX_RDY:                // new data in current DMA buffer
+      {
+        struct uart_event_rx *rx = &evt->data.rx;
+        bl_ring_put_n(&rxring, rx->buf + rx->offset, rx->len);
+        LOG(7,"UART receive: #%d", (int)rx->len);
+        bl_enqueue(&wq,&avail,bl_ring_count(&rxring));  // -> (PMI)
+        break;
+      }
+
+      case UART_RX_BUF_REQUEST:        // provide the released DMA buffer
+        uart_rx_buf_rsp(dev, dmabuf[dmaix], CFG_UART_DMA_SIZE);
+        dmaix ^= 1;
+        break;
+
+      case UART_RX_DISABLED:           // e.g. after line error => restart
+        rx_start();
+        break;
+
+      case UART_TX_DONE:
+      case UART_TX_ABORTED:            // aborted: release only sent bytes
+        bl_ring_get_finish(&txring, evt->type == UART_TX_DONE ? txlen
+                                    : (uint32_t)evt->data.tx.len);
+        txlen = 0;
+        atomic_clear(&txbusy);
+
+        if (atomic_clear(&txfull))     // writer was blocked?
+          bl_enqueue(&wq,&full,0);     // [#UART:FULL 0] -> (PMI)
+
+        tx_kick();                     // continue with pending TX data
+        break;
+
+      default:
+        break;
+    }
   }
 
+#endif // CFG_UART_ASYNC
+
 //==============================================================================
-// helper: is UART write buffer fu
+// helper: is UART write buffer full?
 //==============================================================================
 
     static bool is_full(void)
     {
+    #if CFG_UART_ASYNC
+      if (bl_ring_space(&txring) > 0)
+        return false;
+
+      atomic_set(&txfull,1);           // [#UART:FULL 0] when drained
+      return true;
+    #else
       return false;
+    #endif
     }
 
 //==============================================================================
@@ -118,10 +275,45 @@
 
     count++;
     LOG(7, "UART send(0x%02X)", byte);
+
+  #if CFG_UART_ASYNC
+    if (bl_ring_put_n(&txring, &byte, 1) == 0)
+    {
+      atomic_set(&txfull,1);           // [#UART:FULL 0] when drained
+      return -1;                       // TX ring full
+    }
+
+    tx_kick();
+  #else
     uart_poll_out(uart, byte);         // waits until the transmitter empty
+  #endif
     return 0;
   }
 
+//==============================================================================
+// helper: send buffer via UART, return number of accepted bytes
+//==============================================================================
+
+  static int uart_send_n(const BL_byte *data, int len)
+  {
+    if (len < 0)
+      return -EINVAL;
+
+  #if CFG_UART_ASYNC
+    int n = bl_ring_put_n(&txring, data, len);
+
+    if (n < len)
+      atomic_set(&txfull,1);           // [#UART:FULL 0] when drained
+
+    tx_kick();
+    return n;
+  #else
+    for (int i=0; i < len; i++)
+      uart_poll_out(uart, data[i]);    // waits until the transmitter empty
+    return len;
+  #endif
+  }
+
 //==============================================================================
 // handler: [UART:AVAIL] is a received UART byte available for read?
 //==============================================================================
@@ -137,6 +329,8 @@
 //==============================================================================
 // handler: [UART:READ] read received byte from UART ring buffer
 // - note: always check before whether there is a byte available for read
+// - [UART:READ @size,<buf>] reads up to size bytes into buffer and returns
+//   the number of bytes read (0 if none available)
 //==============================================================================
 
   static int uart_read(BL_ob *o, int val)
@@ -144,6 +338,13 @@
     if (uart == NULL)
       return bl_err(-3,"UART not initialized");
 
+    if (o->data)                       // bulk read?
+    {
+      int n = bl_ring_get_n(&rxring, bl_data(o), o->ix);
+      LOG(6, "UART read: %d bytes", n);
+      return n;
+    }
+
     if (!bl_ring_avail(&rxring))
     {
       LOG(6, "UART read: no byte available");
@@ -171,6 +372,8 @@
 //==============================================================================
 // handler: [UART:WRITE byte] write byte
 // - note: before writing always check whether write buffer is full
+// - [UART:WRITE @len,<buf>] writes len bytes from buffer and returns number
+//   of bytes accepted (less than len if TX buffer runs full)
 //==============================================================================
 
   static int uart_write(BL_ob *o, int val)
@@ -180,6 +383,15 @@
     if (uart == NULL)
       return bl_err(-5,"UART not initialized");
 
+    if (o->data)                       // bulk write?
+    {
+      if (o->ix < 0)
+        return bl_err(-EINVAL,"UART write: negative length");
+
+      LOG(6, "write %d bytes to UART", o->ix);
+      return uart_send_n(o->data, o->ix);
+    }
+
     LOG(6, "write <0x%02X> to UART", byte);
 
     return uart_send(byte);
@@ -193,7 +405,7 @@
   {
     struct uart_config cfg =
            {
-             baudrate:  57600,
+             baudrate:  CFG_UART_BAUDRATE,
              parity:    UART_CFG_PARITY_NONE,
              stop_bits: UART_CFG_STOP_BITS_1,
              data_bits: UART_CFG_DATA_BITS_8,
@@ -220,6 +432,21 @@
       return bl_err(err,"UART: cannot configure");
     }
 
+  #if CFG_UART_ASYNC
+    bl_ring_init(&txring, txbuf, CFG_UART_TX_SIZE);
+
+    LOG(5, BL_B "UART: setup async callback");
+    err = uart_callback_set(uart, uart_cb, NULL);
+
+    if (!err)
+      err = rx_start();
+
+    if (err)
+    {
+      uart = NULL;                      // make invalid again
+      return bl_err(err,"UART: cannot start async RX");
+    }
+  #else
     uart_irq_rx_disable(uart);
     uart_irq_tx_disable(uart);
 
@@ -229,6 +456,7 @@
     uart_irq_callback_set(uart, uart_isr);
 
     uart_irq_rx_enable(uart);
+  #endif
     return (uart == NULL);              // return err if uart not initialized
   }
 
@@ -248,7 +476,9 @@
 // (D)->    AVAIL ->|                    | is data byte available for read?
 // (D)->     FULL ->|                    | is write buffer full?
 // (D)->     READ ->|                    | read byte from receive buffer
+// (D)->     READ ->|     @size,<buf>    | read up to size bytes into buffer
 // (D)->    WRITE ->|        byte        | write byte to send buffer
+// (D)->    WRITE ->|     @len,<buf>     | write len bytes from buffer
 //                  |....................|
 //                  |       #UART:       | UART output interface
 // (U)<-    AVAIL <-|       count        | data byte is now available for read!
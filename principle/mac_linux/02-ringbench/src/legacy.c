@@ -0,0 +1,66 @@
+// legacy.c - previous bl_ring implementation (byte wise, irq locked, % wrap)
+// - copied for comparison, bl_irq() maps to an empty function on the host
+
+#include <assert.h>
+#include "legacy.h"
+
+static void bl_irq(bool enable) { (void)enable; }  // host: no interrupts
+
+bool legacy_full(LEGACY_ring *r)
+{
+  BL_byte avail;
+  bl_irq(0);
+  avail = r->avail;
+  bl_irq(1);
+  return (avail >= r->size);
+}
+
+void legacy_put(LEGACY_ring *r, BL_byte byte)
+{
+  if ( legacy_full(r) )
+  {
+    r->overflow++;
+    return;
+  }
+
+  r->buf[r->iput] = byte;
+  bl_irq(0);
+  r->avail++;
+  bl_irq(1);
+
+  r->iput = (r->iput + 1) % r->size;
+}
+
+bool legacy_avail(LEGACY_ring *r)
+{
+  BL_byte avail;
+  bl_irq(0);
+  avail = r->avail;
+  bl_irq(1);
+  return avail > 0;
+}
+
+BL_byte legacy_get(LEGACY_ring *r)
+{
+  BL_byte byte = 0xFF;
+  if ( !legacy_avail(r) )
+    r->underflow++;
+  else
+  {
+    byte = r->buf[r->iget];
+    bl_irq(0);
+    r->avail--;
+    bl_irq(1);
+    r->iget = (r->iget + 1) % r->size;
+  }
+  return byte;
+}
+
+void legacy_init(LEGACY_ring *r, BL_byte *buf, BL_byte size)
+{
+  assert(size > 0);
+  r->iput = r->iget = r->avail = 0;
+  r->underflow = r->overflow = 0;
+  r->buf = buf;
+  r->size = size;
+}
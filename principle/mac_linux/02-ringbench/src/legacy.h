@@ -0,0 +1,22 @@
+// legacy.h - previous bl_ring implementation (for comparison)
+
+#ifndef __LEGACY_H__
+#define __LEGACY_H__
+
+#include "bl_type.h"
+
+typedef struct LEGACY_ring
+{
+  BL_byte iput, iget, avail;
+  BL_byte *buf;
+  BL_byte size;
+  BL_word underflow, overflow;
+} LEGACY_ring;
+
+bool legacy_full(LEGACY_ring *r);
+void legacy_put(LEGACY_ring *r, BL_byte byte);
+bool legacy_avail(LEGACY_ring *r);
+BL_byte legacy_get(LEGACY_ring *r);
+void legacy_init(LEGACY_ring *r, BL_byte *buf, BL_byte size);
+
+#endif // __LEGACY_H__
@@ -0,0 +1,146 @@
+// main.c - bl_ring throughput benchmark (host)
+// - single thread: producer and consumer alternate in chunks, comparing the
+//   legacy byte ring with the SPSC ring (byte wise and bulk)
+// - two threads: producer and consumer run concurrently on the SPSC ring,
+//   the consumer verifies the byte sequence (lock free correctness check)
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bl_ring.h"
+#include "legacy.h"
+
+#define TOTAL  (64u*1024*1024)         // bytes per benchmark
+#define CHUNK  64                      // bytes per producer/consumer turn
+
+static double seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+static void report(const char *name, double t, uint32_t sum)
+{
+  printf("%-28s %8.1f MB/s  (%6.2f ns/byte, sum %08x)\n",
+         name, TOTAL/t/1e6, t*1e9/TOTAL, sum);
+}
+
+static void bench_legacy(void)
+{
+  static BL_byte buf[128];
+  LEGACY_ring r;
+  uint32_t sum = 0;
+  legacy_init(&r,buf,sizeof(buf));
+
+  double t = seconds();
+  for (uint32_t n=0; n < TOTAL; n += CHUNK)
+  {
+    for (int i=0; i < CHUNK; i++)
+      if (!legacy_full(&r)) legacy_put(&r,(BL_byte)(n+i));
+    while (legacy_avail(&r))
+      sum += legacy_get(&r);
+  }
+  report("legacy ring, byte wise",seconds()-t,sum);
+}
+
+static void bench_spsc_byte(void)
+{
+  static BL_byte buf[128];
+  BL_ring r;
+  uint32_t sum = 0;
+  bl_ring_init(&r,buf,sizeof(buf));
+
+  double t = seconds();
+  for (uint32_t n=0; n < TOTAL; n += CHUNK)
+  {
+    for (int i=0; i < CHUNK; i++)
+      if (!bl_ring_full(&r)) bl_ring_put(&r,(BL_byte)(n+i));
+    while (bl_ring_avail(&r))
+      sum += bl_ring_get(&r);
+  }
+  report("spsc ring, byte wise",seconds()-t,sum);
+}
+
+static void bench_spsc_bulk(void)
+{
+  static BL_byte buf[128];
+  BL_byte in[CHUNK], out[CHUNK];
+  BL_ring r;
+  uint32_t sum = 0;
+  bl_ring_init(&r,buf,sizeof(buf));
+
+  double t = seconds();
+  for (uint32_t n=0; n < TOTAL; n += CHUNK)
+  {
+    for (int i=0; i < CHUNK; i++)
+      in[i] = (BL_byte)(n+i);
+    bl_ring_put_n(&r,in,CHUNK);
+    uint32_t k = bl_ring_get_n(&r,out,CHUNK);
+    for (uint32_t i=0; i < k; i++)
+      sum += out[i];
+  }
+  report("spsc ring, bulk",seconds()-t,sum);
+}
+
+  // two thread test
+
+static BL_byte tbuf[4096];
+static BL_ring tring;
+
+static void *producer(void *arg)
+{
+  BL_byte chunk[CHUNK];
+  for (uint32_t n=0; n < TOTAL; )
+  {
+    for (int i=0; i < CHUNK; i++)
+      chunk[i] = (BL_byte)(n+i);
+    uint32_t done = 0;
+    while (done < CHUNK)
+    {
+      uint32_t k = bl_ring_put_n(&tring,chunk+done,CHUNK-done);
+      if (k == 0)
+        sched_yield();                 // ring full: let consumer run
+      done += k;
+    }
+    n += CHUNK;
+  }
+  return arg;
+}
+
+static void bench_threads(void)
+{
+  pthread_t th;
+  BL_byte out[CHUNK];
+  uint32_t errors = 0, sum = 0;
+
+  bl_ring_init(&tring,tbuf,sizeof(tbuf));
+
+  double t = seconds();
+  pthread_create(&th,NULL,producer,NULL);
+  for (uint32_t n=0; n < TOTAL; )
+  {
+    uint32_t k = bl_ring_get_n(&tring,out,CHUNK);
+    if (k == 0)
+      sched_yield();                   // ring empty: let producer run
+    for (uint32_t i=0; i < k; i++, n++)
+    {
+      errors += (out[i] != (BL_byte)n);
+      sum += out[i];
+    }
+  }
+  pthread_join(th,NULL);
+  report("spsc ring, 2 threads, bulk",seconds()-t,sum);
+  printf("2 thread sequence errors: %u\n",errors);
+}
+
+int main(void)
+{
+  bench_legacy();
+  bench_spsc_byte();
+  bench_spsc_bulk();
+  bench_threads();
+  return 0;
+}
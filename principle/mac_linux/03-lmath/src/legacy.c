@@ -0,0 +1,83 @@
+// legacy.c - previous float lighting math of state_binding.c
+// - copied for comparison; sqrt() renamed to legacy_sqrt() (libm clash), and
+//   the ctl->temp->range_min/max globals turned into tmin/tmax arguments
+
+#include "legacy.h"
+
+#define MINDIFF 2.25e-308
+
+static float legacy_sqrt(float square)
+{
+	float root, last, diff;
+
+	root = square / 3.0;
+	diff = 1;
+
+	if (square <= 0) {
+		return 0;
+	}
+
+	do {
+		last = root;
+		root = (root + square / root) / 2.0;
+		diff = root - last;
+	} while (diff > MINDIFF || diff < -MINDIFF);
+
+	return root;
+}
+
+static int32_t ceiling(float num)
+{
+	int32_t inum;
+
+	inum = (int32_t) num;
+	if (num == (float) inum) {
+		return inum;
+	}
+
+	return inum + 1;
+}
+
+uint16_t legacy_act2lin(uint16_t val)
+{
+	float tmp;
+
+	tmp = ((float) val / UINT16_MAX);
+
+	return (uint16_t) ceiling(UINT16_MAX * tmp * tmp);
+}
+
+uint16_t legacy_lin2act(uint16_t val)
+{
+	return (uint16_t) (UINT16_MAX * legacy_sqrt(((float) val / UINT16_MAX)));
+}
+
+int16_t legacy_temp2level(uint16_t temp, uint16_t tmin, uint16_t tmax)
+{
+	float tmp;
+
+	/* Mesh Model Specification 6.1.3.1.1 2nd formula start */
+
+	tmp = (temp - tmin) * UINT16_MAX;
+
+	tmp = tmp / (tmax - tmin);
+
+	return (int16_t) (tmp + INT16_MIN);
+
+	/* 6.1.3.1.1 2nd formula end */
+}
+
+uint16_t legacy_level2temp(int16_t level, uint16_t tmin, uint16_t tmax)
+{
+	uint16_t tmp;
+	float diff;
+
+	/* Mesh Model Specification 6.1.3.1.1 1st formula start */
+	diff = (float) (tmax - tmin) / UINT16_MAX;
+
+	tmp = (uint16_t) ((level - INT16_MIN) * diff);
+
+	return (tmin + tmp);
+
+	/* 6.1.3.1.1 1st formula end */
+}
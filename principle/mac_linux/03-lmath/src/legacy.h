@@ -0,0 +1,13 @@
+// legacy.h - previous float lighting math of state_binding.c (for comparison)
+
+#ifndef __LEGACY_H__
+#define __LEGACY_H__
+
+#include <stdint.h>
+
+uint16_t legacy_act2lin(uint16_t act);
+uint16_t legacy_lin2act(uint16_t lin);
+int16_t legacy_temp2level(uint16_t temp, uint16_t tmin, uint16_t tmax);
+uint16_t legacy_level2temp(int16_t level, uint16_t tmin, uint16_t tmax);
+
+#endif // __LEGACY_H__
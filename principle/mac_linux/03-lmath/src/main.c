@@ -0,0 +1,155 @@
+// main.c - bl_lmath exhaustive check and benchmark (host)
+// - every one of the 65536 inputs of each conversion is checked against an
+//   exact reference of the Mesh Model Specification formula (64-bit integer
+//   math) and compared with the previous float implementation
+// - cycles per conversion are measured for bl_lmath and the float version
+//   (time stamp counter on x86, nanoseconds elsewhere)
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "bl_lmath.h"
+#include "legacy.h"
+
+#define TMIN   800                     // CTL temperature range (Kelvin)
+#define TMAX 20000
+#define ROUNDS  64                     // benchmark rounds over all inputs
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define UNIT "cycles"
+  static uint64_t stamp(void) { return __rdtsc(); }
+#else
+  #define UNIT "ns"
+  static uint64_t stamp(void)
+  {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec*1000000000u + ts.tv_nsec;
+  }
+#endif
+
+  // exact references (spec formulas in 64-bit integer math)
+
+static uint16_t ref_act2lin(uint16_t act)      // ceil(act^2 / 65535)
+{
+  uint64_t sq = (uint64_t)act * act;
+  return (uint16_t)((sq + 65534) / 65535);
+}
+
+static uint16_t ref_lin2act(uint16_t lin)      // floor(sqrt(lin * 65535))
+{
+  uint64_t x = (uint64_t)lin * 65535;
+  uint64_t r = (uint64_t)sqrt((double)x);
+  while (r*r > x) r--;
+  while ((r+1)*(r+1) <= x) r++;
+  return (uint16_t)r;
+}
+
+static int16_t ref_temp2level(uint16_t temp)   // saturated to [TMIN,TMAX]
+{
+  int64_t t = temp < TMIN ? TMIN : temp > TMAX ? TMAX : temp;
+  return (int16_t)((t - TMIN) * 65535 / (TMAX - TMIN) - 32768);
+}
+
+static uint16_t ref_level2temp(int16_t level)
+{
+  return (uint16_t)(TMIN + ((int64_t)level + 32768) * (TMAX-TMIN) / 65535);
+}
+
+  // exhaustive check
+
+static int failed = 0;
+
+static void verdict(const char *name, int bad, int diff, int maxdev)
+{
+  printf("%-14s 65536 inputs: %5d mismatches vs spec, "
+         "%5d differ from float (max deviation %d)\n",
+         name, bad, diff, maxdev);
+  failed += bad;
+}
+
+static void track(int a, int b, int *diff, int *maxdev)
+{
+  int d = a > b ? a - b : b - a;
+  *diff += (d != 0);
+  if (d > *maxdev) *maxdev = d;
+}
+
+static void check(void)
+{
+  int bad, diff, maxdev;
+
+  bad = diff = maxdev = 0;
+  for (uint32_t i=0; i <= UINT16_MAX; i++)
+  {
+    bad += bl_act2lin(i) != ref_act2lin(i);
+    track(bl_act2lin(i),legacy_act2lin(i),&diff,&maxdev);
+  }
+  verdict("bl_act2lin",bad,diff,maxdev);
+
+  bad = diff = maxdev = 0;
+  for (uint32_t i=0; i <= UINT16_MAX; i++)
+  {
+    bad += bl_lin2act(i) != ref_lin2act(i);
+    track(bl_lin2act(i),legacy_lin2act(i),&diff,&maxdev);
+  }
+  verdict("bl_lin2act",bad,diff,maxdev);
+
+  bad = diff = maxdev = 0;             // float version only defined in range
+  for (uint32_t i=0; i <= UINT16_MAX; i++)
+  {
+    bad += bl_temp2level(i,TMIN,TMAX) != ref_temp2level(i);
+    if (i >= TMIN && i <= TMAX)
+      track(bl_temp2level(i,TMIN,TMAX),legacy_temp2level(i,TMIN,TMAX),
+            &diff,&maxdev);
+  }
+  verdict("bl_temp2level",bad,diff,maxdev);
+
+  bad = diff = maxdev = 0;
+  for (int32_t i=INT16_MIN; i <= INT16_MAX; i++)
+  {
+    bad += bl_level2temp(i,TMIN,TMAX) != ref_level2temp(i);
+    track(bl_level2temp(i,TMIN,TMAX),legacy_level2temp(i,TMIN,TMAX),
+          &diff,&maxdev);
+  }
+  verdict("bl_level2temp",bad,diff,maxdev);
+}
+
+  // benchmark (volatile sink keeps the compiler from dropping calls)
+
+static volatile uint32_t sink;
+
+#define BENCH(name,expr)                                                 \
+  {                                                                      \
+    uint32_t sum = 0;                                                    \
+    uint64_t t0 = stamp();                                               \
+    for (int r=0; r < ROUNDS; r++)                                       \
+      for (uint32_t i=0; i <= UINT16_MAX; i++)                           \
+        sum += (uint16_t)(expr);                                         \
+    uint64_t t = stamp() - t0;                                           \
+    sink = sum;                                                          \
+    printf("%-28s %7.1f " UNIT "/call\n", name,                          \
+           (double)t / (ROUNDS * 65536.0));                              \
+  }
+
+static void bench(void)
+{
+  BENCH("bl_act2lin",          bl_act2lin(i));
+  BENCH("float act2lin",       legacy_act2lin(i));
+  BENCH("bl_lin2act",          bl_lin2act(i));
+  BENCH("float lin2act",       legacy_lin2act(i));
+  BENCH("bl_temp2level",       bl_temp2level(i,TMIN,TMAX));
+  BENCH("float temp2level",    legacy_temp2level(TMIN+i%(TMAX-TMIN),TMIN,TMAX));
+  BENCH("bl_level2temp",       bl_level2temp(i,TMIN,TMAX));
+  BENCH("float level2temp",    legacy_level2temp(i,TMIN,TMAX));
+}
+
+int main(void)
+{
+  check();
+  bench();
+  printf("%s\n", failed ? "FAILED" : "all conversions exact");
+  return failed != 0;
+}
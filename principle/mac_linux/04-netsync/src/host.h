@@ -0,0 +1,23 @@
+// host.h - host shim for compiling bl_trans.c (forced include)
+// - bluccino.h needs Zephyr, but the network time code of bl_trans.c only
+//   needs a few Bluccino types and bl_ms(), which main.c simulates per node
+
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#define __BLUCCINO_H__                 // keep bluccino.h out
+
+#include <string.h>
+#include "bl_type.h"
+
+typedef struct BL_trans                // as in bl_mesh.h
+        {
+          int target;
+          int basis;
+          BL_ms begin;
+          int tt;
+        } BL_trans;
+
+BL_ms bl_ms(void);                     // simulated local clock (main.c)
+
+#endif // __HOST_H__
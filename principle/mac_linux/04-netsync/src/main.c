@@ -0,0 +1,156 @@
+// main.c - network time skew simulation (host)
+// - 20 nodes (node 0 = network time master) at 0..4 relay hops from the
+//   master, 5..20 ms relay latency per hop and transmission, random boot time
+//   and +/-50 ppm clock drift per node
+// - the master publishes a time beacon every 10 s (6 beacons) and a bulk
+//   on/off command with 200 ms delay every 500 ms
+// - each slave runs the real bl_trans.c network time code in a child process
+//   of its own (bl_trans.c keeps its state in statics), with bl_ms() being
+//   the node's simulated local clock
+// - start skew := latest - earliest true start time over all nodes per command,
+//   once for the local start (receipt + delay) and once for the network start
+//   time (low 16 bits of network time, expanded like vnd_bulk_set_unack())
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "bl_trans.h"             // host.h is force included (makefile)
+
+#define NODES        20
+#define MAXHOPS       4
+#define LAT_MIN       5                // relay latency per hop (ms)
+#define LAT_MAX      20
+#define BEACONS       6
+#define PERIOD    10000                // beacon period (ms)
+#define FIRST      1000                // first beacon (true time, ms)
+#define DELAY       200                // command delay (ms)
+#define STEP        500                // command period (ms)
+#define CMDS   ((BEACONS*PERIOD - 2*STEP) / STEP)
+
+typedef struct Start { double local, net; } Start;
+
+  // simulated local clock of this node (true time -> local time)
+
+static double now;                     // true time (ms)
+static double boot;                    // local clock offset (ms)
+static double drift;                   // clock drift (ppm)
+
+BL_ms bl_ms(void)
+{
+  return (BL_ms)(boot + now * (1.0 + drift*1e-6));
+}
+
+static double true_time(BL_ms local)   // local time -> true time
+{
+  return (local - boot) / (1.0 + drift*1e-6);
+}
+
+static int latency(int hops)           // total relay latency (ms)
+{
+  int ms = 0;
+  for (int h=0; h < hops; h++)
+    ms += LAT_MIN + rand() % (LAT_MAX - LAT_MIN + 1);
+  return ms;
+}
+
+  // run a node: deliver beacons and commands in true time order
+
+static void node(int hops, Start *s)
+{
+  int b = 0, c = 0;
+  double tb = FIRST, tc = FIRST + 2*STEP;   // true send times
+
+  while (c < CMDS)
+  {
+    if (b < BEACONS && tb <= tc)       // time beacon [VNDSRV:TIME]
+    {
+      BL_ms net = (BL_ms)tb;           // master clock is network time
+      now = tb + latency(hops);
+      bl_net_sync(net + hops * CFG_NETTIME_HOP_MS);
+      b++;  tb += PERIOD;
+    }
+    else                               // bulk command [VNDSRV:BULK]
+    {
+      uint16_t low = (uint16_t)((BL_ms)tc + DELAY);
+      now = tc + latency(hops);
+
+      s[c].local = true_time(bl_ms() + DELAY);
+
+      BL_ms at = bl_net_ms();
+      at += (int16_t)(low - (uint16_t)at);
+      BL_ms begin = bl_net2ms(at);
+      s[c].net = true_time(begin > bl_ms() ? begin : bl_ms());
+      c++;  tc += STEP;
+    }
+  }
+}
+
+int main(void)
+{
+  static Start start[NODES][CMDS];
+  int hops[NODES];
+
+  srand(4711);
+  for (int n=0; n < NODES; n++)
+    hops[n] = n == 0 ? 0 : 1 + (n-1) % MAXHOPS;
+
+  for (int c=0; c < CMDS; c++)         // master begins right on time
+    start[0][c].local = start[0][c].net = FIRST + 2*STEP + c*STEP + DELAY;
+
+  for (int n=1; n < NODES; n++)
+  {
+    int fd[2];
+    if (pipe(fd) < 0)
+      return perror("pipe"), 1;
+
+    int seed = rand();
+    pid_t pid = fork();
+
+    if (pid == 0)                      // child: fresh bl_trans.c state
+    {
+      srand(seed);
+      boot = rand() % 5000;
+      drift = rand() % 101 - 50;
+      node(hops[n],start[n]);
+      write(fd[1],start[n],sizeof(start[n]));
+      _exit(0);
+    }
+
+    close(fd[1]);
+    if (read(fd[0],start[n],sizeof(start[n])) != sizeof(start[n]))
+      return fprintf(stderr,"node %d failed\n",n), 1;
+    close(fd[0]);
+    waitpid(pid,NULL,0);
+  }
+
+  double sum[2] = {0,0}, max[2] = {0,0};
+
+  for (int c=0; c < CMDS; c++)
+  {
+    double lo[2] = {1e12,1e12}, hi[2] = {-1e12,-1e12};
+    for (int n=0; n < NODES; n++)
+    {
+      double t[2] = {start[n][c].local, start[n][c].net};
+      for (int k=0; k < 2; k++)
+      {
+        if (t[k] < lo[k]) lo[k] = t[k];
+        if (t[k] > hi[k]) hi[k] = t[k];
+      }
+    }
+    for (int k=0; k < 2; k++)
+    {
+      sum[k] += hi[k] - lo[k];
+      if (hi[k] - lo[k] > max[k]) max[k] = hi[k] - lo[k];
+    }
+  }
+
+  printf("%d nodes, 0..%d hops, %d..%d ms/hop, %d beacons, %d commands\n",
+         NODES, MAXHOPS, LAT_MIN, LAT_MAX, BEACONS, CMDS);
+  printf("start skew (local start):   avg %5.1f ms, max %5.1f ms\n",
+         sum[0]/CMDS, max[0]);
+  printf("start skew (network start): avg %5.1f ms, max %5.1f ms\n",
+         sum[1]/CMDS, max[1]);
+  return 0;
+}